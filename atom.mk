@@ -16,12 +16,24 @@ LOCAL_CFLAGS := -D_FILE_OFFSET_BITS=64
 LOCAL_CXXFLAGS := -std=c++11
 
 LOCAL_SRC_FILES := \
+	src/bloom.c \
+	src/deque.c \
+	src/flathash.c \
 	src/hash.c \
+	src/heap.c \
+	src/lru.c \
 	src/mbox.c \
+	src/mpmc.c \
+	src/phash.c \
 	src/systimetools.c \
+	src/timerwheel.c \
 	src/timetools.c \
 	src/random.c \
-	src/varint.c
+	src/rbtree.c \
+	src/slotmap.c \
+	src/strhash.c \
+	src/varint.c \
+	src/vec.c
 
 ifeq ("$(TARGET_OS)", "linux")
   LOCAL_SRC_FILES += src/inotify.c
@@ -39,9 +51,11 @@ endif
 
 ifeq ($(filter "hexagon" "windows", "$(TARGET_OS)"),)
 LOCAL_SRC_FILES += \
+	src/chash.c \
 	src/fdutils.c \
 	src/fs.c \
 	src/safew.c \
+	src/spsc.c \
 	src/synctools.c
 else ifeq ("$(TARGET_OS)", "windows")
 LOCAL_LDLIBS += -lws2_32
@@ -62,13 +76,26 @@ include $(CLEAR_VARS)
 LOCAL_MODULE := tst-libfutils
 LOCAL_SRC_FILES := \
 	tests/futils_test.c \
+	tests/futils_test_bloom.c \
+	tests/futils_test_deque.c \
 	tests/futils_test_dynmbox.c \
+	tests/futils_test_flathash.c \
+	tests/futils_test_hash.c \
+	tests/futils_test_heap.c \
 	tests/futils_test_list.c \
+	tests/futils_test_lru.c \
 	tests/futils_test_mbox.c \
+	tests/futils_test_mpmc.c \
+	tests/futils_test_phash.c \
 	tests/futils_test_random.c \
+	tests/futils_test_rbtree.c \
+	tests/futils_test_slotmap.c \
+	tests/futils_test_strhash.c \
 	tests/futils_test_systimetools.c \
+	tests/futils_test_timerwheel.c \
 	tests/futils_test_timetools.c \
-	tests/futils_test_varint.c
+	tests/futils_test_varint.c \
+	tests/futils_test_vec.c
 
 ifeq ("$(TARGET_OS)", "linux")
   ifneq ("$(TARGET_OS_FLAVOUR)", "android")
@@ -79,9 +106,16 @@ endif
 
 ifneq ("$(TARGET_OS)","windows")
 LOCAL_SRC_FILES += \
+	tests/futils_test_mpscq.c \
 	tests/futils_test_safew.c
 endif
 
+ifeq ($(filter "hexagon" "windows", "$(TARGET_OS)"),)
+LOCAL_SRC_FILES += \
+	tests/futils_test_chash.c \
+	tests/futils_test_spsc.c
+endif
+
 LOCAL_LIBRARIES := libfutils libcunit
 
 ifeq ("$(TARGET_OS)","windows")
@@ -91,6 +125,7 @@ endif
 ifeq (,$(filter $(TARGET_OS)-$(TARGET_OS_FLAVOUR), baremetal-liteos))
 LOCAL_SRC_FILES += \
 	tests/futils_test_fs.cpp \
+	tests/futils_test_hashmap.cpp \
 	tests/futils_test_string.cpp
 endif
 
@@ -106,3 +141,12 @@ LOCAL_SRC_FILES := \
 	tests/futils_random.c
 LOCAL_LIBRARIES := libfutils
 include $(BUILD_EXECUTABLE)
+
+include $(CLEAR_VARS)
+LOCAL_MODULE := futils-hash-bench
+LOCAL_CATEGORY_PATH := test
+LOCAL_DESCRIPTION := futils hash table benchmark
+LOCAL_SRC_FILES := \
+	tests/futils_hash_bench.c
+LOCAL_LIBRARIES := libfutils
+include $(BUILD_EXECUTABLE)
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file bloom.h
+ *
+ * @brief blocked Bloom filter
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_BLOOM_H_
+#define _FUTILS_BLOOM_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Blocked Bloom filter.
+ *
+ * Approximate set membership: a test never misses a key that was added, but
+ * may report a key that was not (false positive). All bits of a key are set
+ * in a single 64 bytes block, so a test reads one cache line only and can
+ * cheaply reject most misses before a hash table lookup.
+ *
+ * Keys cannot be removed, the filter has to be cleared and filled again.
+ */
+struct futils_bloom;
+
+/**
+ * create a new Bloom filter
+ * @param size expected number of keys
+ * @param bits_per_key number of bits per key, the false positive rate is
+ * about 1% with 10 bits per key, and is divided by 2 for each 1.5 more bits
+ * @return filter on success, NULL on error
+ */
+struct futils_bloom *futils_bloom_new(size_t size, uint32_t bits_per_key);
+
+/**
+ * destroy Bloom filter
+ * @param bloom
+ */
+void futils_bloom_destroy(struct futils_bloom *bloom);
+
+/**
+ * remove all keys from Bloom filter
+ * @param bloom
+ * @return 0 on success
+ */
+int futils_bloom_clear(struct futils_bloom *bloom);
+
+/**
+ * add an integer key to Bloom filter
+ * @param bloom
+ * @param key key, hashed like struct futils_flathash keys
+ * @return 0 on success
+ */
+int futils_bloom_add_u32(struct futils_bloom *bloom, uint32_t key);
+
+/**
+ * test if an integer key may have been added to Bloom filter
+ * @param bloom
+ * @param key key
+ * @return 0 if key was not added, 1 if it may have been added, negative
+ * errno on error
+ */
+int futils_bloom_test_u32(const struct futils_bloom *bloom, uint32_t key);
+
+/**
+ * add a byte string key to Bloom filter
+ * @param bloom
+ * @param data key bytes, hashed like struct futils_strhash keys
+ * @param len key length
+ * @return 0 on success
+ */
+int futils_bloom_add_bytes(struct futils_bloom *bloom, const void *data,
+			   size_t len);
+
+/**
+ * test if a byte string key may have been added to Bloom filter
+ * @param bloom
+ * @param data key bytes
+ * @param len key length
+ * @return 0 if key was not added, 1 if it may have been added, negative
+ * errno on error
+ */
+int futils_bloom_test_bytes(const struct futils_bloom *bloom, const void *data,
+			    size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_BLOOM_H_*/
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file chash.h
+ *
+ * @brief concurrent hash table
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_CHASH_H_
+#define _FUTILS_CHASH_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Thread safe hash table.
+ *
+ * Keys are spread over independent lock stripes, each one being a struct hash
+ * protected by its own read/write lock on a dedicated cache line. Lookups on
+ * different stripes never contend, and lookups on the same stripe only share
+ * a read lock.
+ *
+ * Data returned by a lookup is not protected once the function returns: the
+ * caller must ensure that it is not removed (and freed by the hfree callback)
+ * by another thread while it is still in use.
+ */
+struct futils_chash;
+
+/**
+ * create a new concurrent hash table
+ * @param size expected number of entries, the table grows when needed
+ * @param hfree allocator free callback
+ * @return hash table on success, NULL on error
+ */
+struct futils_chash *futils_chash_new(size_t size, void (*hfree)(void *));
+
+/**
+ * destroy concurrent hash table
+ * @warning There must be no other in-use reference to the table to destroy.
+ * @param hash
+ */
+void futils_chash_destroy(struct futils_chash *hash);
+
+/**
+ * insert an entry in concurrent hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_chash_insert(struct futils_chash *hash, uint32_t key, void *data);
+
+/**
+ * insert a const entry in concurrent hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_chash_insert_const(struct futils_chash *hash, uint32_t key,
+			      const void *data);
+
+/**
+ * remove an entry from concurrent hash table
+ *
+ * @param hash hash table
+ * @param key entry key to be removed
+ * @return 0 if entry is found and removed
+ */
+int futils_chash_remove(struct futils_chash *hash, uint32_t key);
+
+/**
+ * remove all entries from concurrent hash table
+ *
+ * @param hash hash table
+ * @return 0 if hash is cleared
+ */
+int futils_chash_remove_all(struct futils_chash *hash);
+
+/**
+ * lookup to an entry in concurrent hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found, -EPERM if entry is const
+ */
+int futils_chash_lookup(struct futils_chash *hash, uint32_t key, void **data);
+
+/**
+ * lookup to a const entry in concurrent hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found
+ */
+int futils_chash_lookup_const(struct futils_chash *hash, uint32_t key,
+			      const void **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_CHASH_H_*/
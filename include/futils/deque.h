@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file deque.h
+ *
+ * @brief chunked double ended queue
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_DEQUE_H_
+#define _FUTILS_DEQUE_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Double ended queue of fixed size elements.
+ *
+ * Elements are stored in fixed size blocks linked together, so a block is
+ * allocated only once every block_size pushes, and draining the queue reads
+ * memory sequentially. One empty block is kept to avoid allocating and
+ * freeing a block repeatedly when the queue size oscillates around a block
+ * boundary. Push and pop at both ends are O(1).
+ */
+struct futils_deque;
+
+/**
+ * create a new deque
+ * @param elem_size size of elements
+ * @param block_size number of elements per block, 0 for a default value
+ * @return deque on success, NULL on error
+ */
+struct futils_deque *futils_deque_new(size_t elem_size, size_t block_size);
+
+/**
+ * destroy deque
+ * @param deque
+ */
+void futils_deque_destroy(struct futils_deque *deque);
+
+/**
+ * remove all elements and free blocks
+ * @param deque
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_deque_clear(struct futils_deque *deque);
+
+/**
+ * add an element at the back
+ * @param deque
+ * @param elem element to copy, NULL to zero the new element
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_deque_push_back(struct futils_deque *deque, const void *elem);
+
+/**
+ * add an element at the front
+ * @param deque
+ * @param elem element to copy, NULL to zero the new element
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_deque_push_front(struct futils_deque *deque, const void *elem);
+
+/**
+ * remove the element at the back
+ * @param deque
+ * @param elem copy of removed element, can be NULL
+ * @return 0 on success, -ENOENT if deque is empty
+ */
+int futils_deque_pop_back(struct futils_deque *deque, void *elem);
+
+/**
+ * remove the element at the front
+ * @param deque
+ * @param elem copy of removed element, can be NULL
+ * @return 0 on success, -ENOENT if deque is empty
+ */
+int futils_deque_pop_front(struct futils_deque *deque, void *elem);
+
+/**
+ * get the element at the front
+ * @param deque
+ * @return element pointer, valid until next modification, NULL if empty
+ */
+void *futils_deque_front(const struct futils_deque *deque);
+
+/**
+ * get the element at the back
+ * @param deque
+ * @return element pointer, valid until next modification, NULL if empty
+ */
+void *futils_deque_back(const struct futils_deque *deque);
+
+/**
+ * get the number of elements
+ * @param deque
+ * @return number of elements
+ */
+size_t futils_deque_count(const struct futils_deque *deque);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_DEQUE_H_*/
@@ -36,6 +36,7 @@
  * limit in the number of messages or in the number of bytes stored in the
  * queue. However, it is guaranteed that an empty mailbox can queue at least
  * one message of the maximum size allocated at creation time.
+ * The read file descriptor is readable as long as the mailbox is not empty.
  * The behaviour in the case of multiple producers is completely unspecified,
  * though no runtime check is done in order to verify that there is only one
  * producer per mailbox.
@@ -148,6 +149,36 @@ int dynmbox_push_block(struct dynmbox *box,
  */
 ssize_t dynmbox_peek(struct dynmbox *box, void *msg);
 
+/**
+ * @brief callback called for each message read by dynmbox_peek_all()
+ *
+ * @param[in] msg The message, only valid during the call
+ * @param[in] msg_size Size of the message
+ * @param[in] userdata User data given to dynmbox_peek_all()
+ */
+typedef void (*dynmbox_peek_cb_t)(const void *msg, size_t msg_size,
+				  void *userdata);
+
+/**
+ * @brief read all queued messages from the mail box
+ *
+ * Messages are read in order under a single lock acquisition, and given to
+ * the callback without copy unless they wrap around the ring end. The
+ * callback is called with the mail box locked, so it must not call any
+ * function of the same mail box.
+ *
+ * @param[in] box Handle of the mail box
+ * @param[in] cb Function called for each message
+ * @param[in] userdata User data given to the callback
+ *
+ * @return number of messages read on success,
+ *         -EINVAL in case of invalid arguments,
+ *         -EAGAIN if the mail box is empty,
+ *         other negative errno on error
+ */
+int dynmbox_peek_all(struct dynmbox *box, dynmbox_peek_cb_t cb,
+		     void *userdata);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file flathash.h
+ *
+ * @brief open addressing hash table with inline entries
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_FLATHASH_H_
+#define _FUTILS_FLATHASH_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <futils/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * flat hash slot, stored inline in the table
+ */
+struct futils_flathash_slot {
+	uint32_t key;			/* slot key */
+	uint32_t dib:31;		/* distance to initial bucket + 1,
+					 * 0 if slot is empty */
+	uint32_t is_const:1;		/* is entry const */
+	union {
+		void *data;		/* entry data */
+		const void *const_data;	/* entry const data */
+	};
+};
+
+/**
+ * flat hash structure
+ *
+ * Robin Hood open addressing table: keys and data are stored in a single
+ * array of slots, so a lookup touches consecutive memory only and an insert
+ * does not allocate unless the table has to grow.
+ */
+struct futils_flathash {
+	struct futils_flathash_slot *slots;	/* table slots */
+	uint32_t mask;				/* table size - 1 */
+	uint32_t count;				/* number of entries */
+	uint32_t grow_at;			/* count triggering growth */
+	void (*hfree)(void *);		/* allocator free callback */
+};
+
+/**
+ * create a new flat hash table
+ * @param hash
+ * @param size expected number of entries, the table grows when needed
+ * @param hfree allocator free callback, not called for const entries
+ * @return 0 on success
+ */
+int futils_flathash_init(struct futils_flathash *hash, size_t size,
+			 void (*hfree)(void *));
+
+/**
+ * destroy flat hash table
+ * @param hash
+ * @return 0 on success
+ */
+int futils_flathash_destroy(struct futils_flathash *hash);
+
+/**
+ * insert an entry in flat hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_flathash_insert(struct futils_flathash *hash, uint32_t key,
+			   void *data);
+
+/**
+ * insert a const entry in flat hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_flathash_insert_const(struct futils_flathash *hash, uint32_t key,
+				 const void *data);
+
+/**
+ * remove an entry from flat hash table
+ *
+ * @param hash hash table
+ * @param key entry key to be removed
+ * @return 0 if entry is found and removed
+ */
+int futils_flathash_remove(struct futils_flathash *hash, uint32_t key);
+
+/**
+ * remove all entries from flat hash table
+ *
+ * @param hash hash table
+ * @return 0 if hash is cleared
+ */
+int futils_flathash_remove_all(struct futils_flathash *hash);
+
+/**
+ * lookup to an entry in flat hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found, -EPERM if entry is const
+ */
+int futils_flathash_lookup(const struct futils_flathash *hash,
+			   uint32_t key, void **data);
+
+/**
+ * lookup to a const entry in flat hash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found
+ */
+int futils_flathash_lookup_const(const struct futils_flathash *hash,
+				 uint32_t key, const void **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_FLATHASH_H_*/
@@ -122,8 +122,23 @@
  **/
 #include <futils/fdutils.h>
 #include <futils/hash.h>
+#include <futils/flathash.h>
+#include <futils/phash.h>
+#include <futils/strhash.h>
+#include <futils/chash.h>
+#include <futils/lru.h>
+#include <futils/bloom.h>
+#include <futils/heap.h>
+#include <futils/slotmap.h>
+#include <futils/vec.h>
+#include <futils/deque.h>
 #include <futils/list.h>
+#include <futils/mpscq.h>
+#include <futils/spsc.h>
+#include <futils/mpmc.h>
+#include <futils/rbtree.h>
 #include <futils/timetools.h>
+#include <futils/timerwheel.h>
 #include <futils/systimetools.h>
 #include <futils/synctools.h>
 #include <futils/mbox.h>
@@ -35,6 +35,7 @@
 #if defined(__cplusplus)
 
 #include <futils/fs.hpp>
+#include <futils/hashmap.hpp>
 #include <futils/string.hpp>
 
 /** Disable copy constructor and assignment operator */
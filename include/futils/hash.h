@@ -41,6 +41,35 @@
 extern "C" {
 #endif
 
+/**
+ * Mix a 32bit unsigned key into a hash value.
+ * All bits of the key affect all bits of the result (murmur3 finalizer), so
+ * the result can be masked to index a power of two sized table.
+ *
+ * @param key
+ * @return hash value
+ */
+static inline uint32_t futils_hash_u32(uint32_t key)
+{
+	key ^= key >> 16;
+	key *= 0x85ebca6bU;
+	key ^= key >> 13;
+	key *= 0xc2b2ae35U;
+	key ^= key >> 16;
+	return key;
+}
+
+/**
+ * Convert a byte string to a 64bit hash value.
+ * using wyhash function
+ *
+ * @param data bytes to hash
+ * @param len number of bytes
+ * @param seed hash seed
+ * @return hash value
+ */
+uint64_t futils_hash_bytes(const void *data, size_t len, uint64_t seed);
+
 #ifdef FUTILS_LIST
 
 /**
@@ -49,6 +78,7 @@ extern "C" {
 struct hash_entry {
 	struct list_node node;		/* node in hash list entries */
 	int is_const;			/* is entry const */
+	int is_intrusive;		/* is entry owned by caller */
 	union {
 		void *data;		/* entry data */
 		const void *const_data;	/* entry const data */
@@ -57,6 +87,33 @@ struct hash_entry {
 	struct hash_entry *next;	/* next entry with same hash value */
 };
 
+/**
+ * hash lookup counters
+ */
+struct futils_hash_counters {
+	uint64_t lookups;		/* number of lookups */
+	uint64_t probes;		/* number of entries compared */
+};
+
+#define FUTILS_HASH_STATS_HIST_LEN 8
+
+/**
+ * hash statistics, chains of old buckets are included while resizing
+ */
+struct futils_hash_stats {
+	uint32_t size;			/* hash table size */
+	uint32_t count;			/* number of entries */
+	uint32_t load_factor;		/* count in percent of size */
+	uint32_t used_buckets;		/* number of non empty buckets */
+	uint32_t max_chain;		/* longest chain length */
+	uint32_t chain_hist[FUTILS_HASH_STATS_HIST_LEN];
+					/* number of chains per length, last
+					 * one counting longer chains too */
+	uint64_t lookups;		/* lookups, if counters enabled */
+	uint64_t probes;		/* entries compared during lookups,
+					 * if counters enabled */
+};
+
 /**
  * hash structure
  */
@@ -65,6 +122,12 @@ struct hash {
 	uint32_t size;			/* hash table size */
 	struct list_node entries;	/* node entries */
 	void (*hfree)(void *);	/* allocator free callback */
+	uint32_t count;			/* number of entries */
+	uint32_t max_load;		/* growth threshold, 0 if disabled */
+	struct hash_entry **old_buckets;	/* buckets being migrated */
+	uint32_t old_size;		/* size of buckets being migrated */
+	uint32_t migrate_idx;		/* next bucket to migrate */
+	struct futils_hash_counters *counters;	/* lookup counters */
 };
 
 /**
@@ -83,6 +146,20 @@ int futils_hash_init(struct hash *hash, size_t size, void (*hfree)(void *));
  */
 int futils_hash_destroy(struct hash *hash);
 
+/**
+ * enable automatic growth of hash table
+ *
+ * When the number of entries exceeds max_load percent of the table size,
+ * a larger table is allocated and entries are migrated a few buckets at a
+ * time on each insert or remove, so that no operation has to rehash the
+ * whole table. Lookups check both tables while a migration is in progress.
+ *
+ * @param hash hash table
+ * @param max_load maximum load factor in percent, 0 to disable growth
+ * @return 0 on success
+ */
+int futils_hash_set_auto_resize(struct hash *hash, uint32_t max_load);
+
 /**
  * insert an entry in hash table
  *
@@ -104,6 +181,29 @@ int futils_hash_insert(struct hash *hash, uint32_t key, void *data);
 int futils_hash_insert_const(struct hash *hash, uint32_t key,
 			     const void *data);
 
+/**
+ * link a caller owned entry in hash table
+ *
+ * The entry is typically embedded in a caller structure and retrieved after
+ * a lookup with futils_hash_entry(), so no allocation is done. Its data field
+ * is left untouched, and the hash free callback is never called for it.
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param entry entry to link
+ * @return 0 if entry linked, -EEXIST if another entry with same key.
+ */
+int futils_hash_link(struct hash *hash, uint32_t key, struct hash_entry *entry);
+
+/**
+ * unlink a caller owned entry from hash table
+ *
+ * @param hash hash table
+ * @param entry entry previously linked with futils_hash_link()
+ * @return 0 if entry is found and unlinked
+ */
+int futils_hash_unlink(struct hash *hash, struct hash_entry *entry);
+
 /**
  * remove an entry from hash table
  *
@@ -132,6 +232,56 @@ int futils_hash_remove_all(struct hash *hash);
 int futils_hash_lookup(const struct hash *hash,
 		       uint32_t key, void **data);
 
+/**
+ * lookup to several entries in hash table
+ *
+ * Keys are processed in groups: all keys of a group are hashed and their
+ * buckets prefetched before chains are walked, so that memory accesses of
+ * different keys overlap instead of being serialized.
+ *
+ * @param tab hash table
+ * @param keys entries keys
+ * @param n number of keys, at most INT_MAX
+ * @param out entries data pointers, NULL if not found or if entry is const
+ * @return number of entries found, negative errno on error
+ */
+int futils_hash_lookup_batch(const struct hash *hash, const uint32_t *keys,
+			     size_t n, void **out);
+
+/**
+ * lookup to several const entries in hash table
+ *
+ * @param tab hash table
+ * @param keys entries keys
+ * @param n number of keys, at most INT_MAX
+ * @param out entries data pointers, NULL if not found
+ * @return number of entries found, negative errno on error
+ */
+int futils_hash_lookup_batch_const(const struct hash *hash,
+				   const uint32_t *keys, size_t n,
+				   const void **out);
+
+/**
+ * lookup to an entry container in hash table
+ *
+ * @param tab hash table
+ * @param key entry key
+ * @param entry entry pointer if entry found
+ * @return return 0 if entry is found
+ */
+int futils_hash_lookup_entry(const struct hash *hash, uint32_t key,
+			     struct hash_entry **entry);
+
+/**
+ * get the structure containing an entry linked with futils_hash_link()
+ *
+ * @param ptr the entry pointer.
+ * @param type the type of the container struct this is embedded in.
+ * @param member the name of the entry within the struct.
+ */
+#define futils_hash_entry(ptr, type, member) \
+	FUTILS_CONTAINER_OF(ptr, type, member)
+
 /**
  * lookup to a const entry in hash table
  *
@@ -143,6 +293,30 @@ int futils_hash_lookup(const struct hash *hash,
 int futils_hash_lookup_const(const struct hash *hash, uint32_t key,
 			     const void **data);
 
+/**
+ * enable or disable cumulative lookup counters
+ *
+ * Counters are updated by lookups (futils_hash_lookup_xxx functions) only,
+ * and are not updated atomically.
+ *
+ * @param hash hash table
+ * @param enable 1 to enable counters, 0 to disable and reset them
+ * @return 0 on success
+ */
+int futils_hash_enable_counters(struct hash *hash, int enable);
+
+/**
+ * get hash table statistics
+ *
+ * Walks all buckets, this is meant for diagnostics, not for fast paths.
+ *
+ * @param hash hash table
+ * @param stats statistics
+ * @return 0 on success
+ */
+int futils_hash_get_stats(const struct hash *hash,
+			  struct futils_hash_stats *stats);
+
 
 /* Define aliases for functions for compatibility with the previous API:
  * we need symbol names to be prefixed only, not the actual definition
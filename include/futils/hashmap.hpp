@@ -0,0 +1,591 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file hashmap.hpp
+ *
+ * @brief Open addressing hash map for C++
+ *
+ *****************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#include <functional>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <futils/hash.h>
+
+namespace futils
+{
+
+/**
+ * @brief Default hash functor of HashMap
+ *
+ * Values are first hashed with std::hash, then mixed so that low bits can be
+ * used as table index.
+ */
+template <class K, class Enable = void>
+struct Hash {
+	uint32_t operator()(const K &key) const
+	{
+		uint64_t h = std::hash<K>()(key);
+		return futils_hash_u32((uint32_t)h ^
+				       futils_hash_u32((uint32_t)(h >> 32)));
+	}
+};
+
+/**
+ * @brief Hash of integer and enum keys
+ */
+template <class K>
+struct Hash<K, typename std::enable_if<std::is_integral<K>::value ||
+				       std::is_enum<K>::value>::type> {
+	uint32_t operator()(K key) const
+	{
+		uint64_t v = (uint64_t)key;
+		if (sizeof(K) <= sizeof(uint32_t))
+			return futils_hash_u32((uint32_t)v);
+		return futils_hash_u32((uint32_t)v ^
+				       futils_hash_u32((uint32_t)(v >> 32)));
+	}
+};
+
+/**
+ * @brief Hash of string keys, also accepting C strings so that a
+ * HashMap<std::string, V> can be searched without building a std::string
+ */
+template <>
+struct Hash<std::string> {
+	typedef void is_transparent;
+
+	uint32_t operator()(const std::string &key) const
+	{
+		return (uint32_t)futils_hash_bytes(key.data(), key.size(), 0);
+	}
+
+	uint32_t operator()(const char *key) const
+	{
+		return (uint32_t)futils_hash_bytes(key, strlen(key), 0);
+	}
+};
+
+/**
+ * @brief Key comparison accepting any pair of comparable types
+ */
+struct EqualTo {
+	typedef void is_transparent;
+
+	template <class A, class B>
+	bool operator()(const A &a, const B &b) const
+	{
+		return a == b;
+	}
+};
+
+/**
+ * @brief Hash map with entries stored inline in an open addressing table
+ *
+ * Entries are std::pair<K, V> constructed in place in a Robin Hood table:
+ * no allocation per entry, and values only need to be move constructible and
+ * move assignable. Distances to initial bucket are kept in a separate array
+ * of uint32_t: probing only reads the entries whose distance matches.
+ *
+ * Lookups of a type other than K are available when both Hash and KeyEqual
+ * define is_transparent.
+ *
+ * Any insertion or removal invalidates iterators and references.
+ */
+template <class K, class V, class H = Hash<K>, class KeyEqual = EqualTo>
+class HashMap {
+public:
+	typedef K key_type;
+	typedef V mapped_type;
+	typedef std::pair<K, V> value_type;
+	typedef size_t size_type;
+
+private:
+	typedef typename std::aligned_storage<sizeof(value_type),
+		std::alignment_of<value_type>::value>::type Slot;
+
+	/* minimum table size, must be a power of 2 */
+	static const size_t MIN_SIZE = 8;
+
+	/* maximum load factor, expressed in eighths */
+	static const size_t MAX_LOAD = 7;
+
+	Slot *mSlots;
+	uint32_t *mDib;		/* distance to initial bucket + 1, 0 if empty */
+	size_t mMask;
+	size_t mCount;
+	H mHash;
+	KeyEqual mEqual;
+
+	value_type *item(size_t idx) const
+	{
+		return reinterpret_cast<value_type *>(&mSlots[idx]);
+	}
+
+	template <class Q>
+	size_t findIndex(const Q &key) const
+	{
+		if (mCount == 0)
+			return npos();
+
+		size_t idx = mHash(key) & mMask;
+		for (uint32_t dib = 1; mDib[idx] >= dib; dib++) {
+			if (mDib[idx] == dib && mEqual(item(idx)->first, key))
+				return idx;
+			idx = (idx + 1) & mMask;
+		}
+		return npos();
+	}
+
+	size_t npos() const
+	{
+		return mMask + 1;
+	}
+
+	/* insert an entry known to be absent, return its index */
+	size_t place(value_type &&entry)
+	{
+		size_t idx = mHash(entry.first) & mMask;
+		size_t pos = npos();
+		uint32_t dib = 1;
+
+		while (mDib[idx] != 0) {
+			if (mDib[idx] < dib) {
+				/* steal the place of a richer entry */
+				std::swap(*item(idx), entry);
+				std::swap(mDib[idx], dib);
+				if (pos == npos())
+					pos = idx;
+			}
+			idx = (idx + 1) & mMask;
+			dib++;
+		}
+
+		new (item(idx)) value_type(std::move(entry));
+		mDib[idx] = dib;
+		mCount++;
+		return pos == npos() ? idx : pos;
+	}
+
+	void rehash(size_t size)
+	{
+		Slot *oldSlots = mSlots;
+		uint32_t *oldDib = mDib;
+		size_t oldSize = oldSlots ? mMask + 1 : 0;
+
+		mSlots = new Slot[size];
+		mDib = new uint32_t[size]();
+		mMask = size - 1;
+		mCount = 0;
+
+		for (size_t i = 0; i < oldSize; i++) {
+			if (oldDib[i] == 0)
+				continue;
+			value_type *old = reinterpret_cast<value_type *>(
+				&oldSlots[i]);
+			place(std::move(*old));
+			old->~value_type();
+		}
+
+		delete[] oldSlots;
+		delete[] oldDib;
+	}
+
+	static size_t tableSize(size_t count)
+	{
+		size_t size = MIN_SIZE;
+		while (size * MAX_LOAD / 8 < count)
+			size *= 2;
+		return size;
+	}
+
+	/* make room for one more entry */
+	void prepareInsert()
+	{
+		if (!mSlots || mCount + 1 > (mMask + 1) * MAX_LOAD / 8)
+			rehash(tableSize(mCount + 1));
+	}
+
+	void eraseIndex(size_t idx)
+	{
+		size_t next = (idx + 1) & mMask;
+
+		/* backward shift of following entries */
+		while (mDib[next] > 1) {
+			*item(idx) = std::move(*item(next));
+			mDib[idx] = mDib[next] - 1;
+			idx = next;
+			next = (next + 1) & mMask;
+		}
+
+		item(idx)->~value_type();
+		mDib[idx] = 0;
+		mCount--;
+	}
+
+	void destroyAll()
+	{
+		for (size_t i = 0; mSlots && i <= mMask; i++) {
+			if (mDib[i] != 0) {
+				item(i)->~value_type();
+				mDib[i] = 0;
+			}
+		}
+		mCount = 0;
+	}
+
+	/* Entry is value_type for iterator, const value_type for
+	 * const_iterator */
+	template <class Map, class Entry>
+	class Iterator {
+		friend class HashMap;
+		template <class, class> friend class Iterator;
+
+	private:
+		typedef typename std::conditional<std::is_const<Entry>::value,
+			const V, V>::type Value;
+
+		Map *mMap;
+		size_t mIdx;
+
+		Iterator(Map *map, size_t idx) : mMap(map), mIdx(idx)
+		{
+			skip();
+		}
+
+		void skip()
+		{
+			while (mIdx < mMap->npos() && mMap->mDib[mIdx] == 0)
+				mIdx++;
+		}
+
+	public:
+		/* convert iterator to const_iterator */
+		operator Iterator<const Map, const Entry>() const
+		{
+			return Iterator<const Map, const Entry>(mMap, mIdx);
+		}
+
+		const K &key() const
+		{
+			return mMap->item(mIdx)->first;
+		}
+
+		Value &value() const
+		{
+			return mMap->item(mIdx)->second;
+		}
+
+		Entry &operator*() const
+		{
+			return *mMap->item(mIdx);
+		}
+
+		Entry *operator->() const
+		{
+			return mMap->item(mIdx);
+		}
+
+		Iterator &operator++()
+		{
+			mIdx++;
+			skip();
+			return *this;
+		}
+
+		bool operator==(const Iterator &other) const
+		{
+			return mIdx == other.mIdx;
+		}
+
+		bool operator!=(const Iterator &other) const
+		{
+			return mIdx != other.mIdx;
+		}
+	};
+
+public:
+	/**
+	 * @brief Iterator over entries, the value being modifiable through
+	 * value(), operator* or operator->
+	 *
+	 * Entries are stored as std::pair<K, V> so that they can be moved
+	 * inside the table: the key must not be modified through the
+	 * iterator, use key() for a read only access.
+	 */
+	typedef Iterator<HashMap, value_type> iterator;
+
+	/**
+	 * @brief Iterator over entries of a const map
+	 */
+	typedef Iterator<const HashMap, const value_type> const_iterator;
+
+	/**
+	 * @brief Create a map
+	 * @param size expected number of entries, the table grows when needed
+	 */
+	explicit HashMap(size_t size = 0)
+		: mSlots(NULL), mDib(NULL), mMask(MIN_SIZE - 1), mCount(0)
+	{
+		if (size > 0)
+			rehash(tableSize(size));
+	}
+
+	HashMap(HashMap &&other)
+		: mSlots(other.mSlots), mDib(other.mDib), mMask(other.mMask),
+		  mCount(other.mCount), mHash(std::move(other.mHash)),
+		  mEqual(std::move(other.mEqual))
+	{
+		other.mSlots = NULL;
+		other.mDib = NULL;
+		other.mMask = MIN_SIZE - 1;
+		other.mCount = 0;
+	}
+
+	HashMap &operator=(HashMap &&other)
+	{
+		if (this != &other) {
+			destroyAll();
+			delete[] mSlots;
+			delete[] mDib;
+			mSlots = other.mSlots;
+			mDib = other.mDib;
+			mMask = other.mMask;
+			mCount = other.mCount;
+			mHash = std::move(other.mHash);
+			mEqual = std::move(other.mEqual);
+			other.mSlots = NULL;
+			other.mDib = NULL;
+			other.mMask = MIN_SIZE - 1;
+			other.mCount = 0;
+		}
+		return *this;
+	}
+
+	HashMap(const HashMap &) = delete;
+	HashMap &operator=(const HashMap &) = delete;
+
+	~HashMap()
+	{
+		destroyAll();
+		delete[] mSlots;
+		delete[] mDib;
+	}
+
+	size_t size() const
+	{
+		return mCount;
+	}
+
+	bool empty() const
+	{
+		return mCount == 0;
+	}
+
+	/**
+	 * @brief Grow the table so that count entries fit without rehashing
+	 * @param count number of entries
+	 */
+	void reserve(size_t count)
+	{
+		size_t size = tableSize(count);
+		if (!mSlots || size > mMask + 1)
+			rehash(size);
+	}
+
+	/**
+	 * @brief Remove all entries, the table size is kept
+	 */
+	void clear()
+	{
+		destroyAll();
+	}
+
+	/**
+	 * @brief Construct an entry in place from pair constructor arguments
+	 * @return iterator to the entry with the same key and true if the
+	 * entry was inserted, false if an entry with same key already exists
+	 */
+	template <class... Args>
+	std::pair<iterator, bool> emplace(Args &&... args)
+	{
+		value_type entry(std::forward<Args>(args)...);
+		size_t idx = findIndex(entry.first);
+		if (idx != npos())
+			return std::make_pair(iterator(this, idx), false);
+
+		prepareInsert();
+		idx = place(std::move(entry));
+		return std::make_pair(iterator(this, idx), true);
+	}
+
+	/**
+	 * @brief Construct a value in place if key is absent, nothing is
+	 * constructed from args otherwise
+	 * @return iterator to the entry with the same key and true if the
+	 * entry was inserted
+	 */
+	template <class KK, class... Args>
+	std::pair<iterator, bool> try_emplace(KK &&key, Args &&... args)
+	{
+		size_t idx = findIndex(key);
+		if (idx != npos())
+			return std::make_pair(iterator(this, idx), false);
+
+		prepareInsert();
+		idx = place(value_type(std::piecewise_construct,
+				       std::forward_as_tuple(
+					       std::forward<KK>(key)),
+				       std::forward_as_tuple(
+					       std::forward<Args>(args)...)));
+		return std::make_pair(iterator(this, idx), true);
+	}
+
+	/**
+	 * @brief Get the value of a key, inserting a default constructed value
+	 * if absent
+	 */
+	V &operator[](const K &key)
+	{
+		return try_emplace(key).first.value();
+	}
+
+	V &operator[](K &&key)
+	{
+		return try_emplace(std::move(key)).first.value();
+	}
+
+	iterator find(const K &key)
+	{
+		return iterator(this, findIndex(key));
+	}
+
+	const_iterator find(const K &key) const
+	{
+		return const_iterator(this, findIndex(key));
+	}
+
+	/**
+	 * @brief Heterogeneous lookup, for transparent Hash and KeyEqual
+	 */
+	template <class Q, class HH = H, class EE = KeyEqual,
+		  class = typename HH::is_transparent,
+		  class = typename EE::is_transparent>
+	iterator find(const Q &key)
+	{
+		return iterator(this, findIndex(key));
+	}
+
+	template <class Q, class HH = H, class EE = KeyEqual,
+		  class = typename HH::is_transparent,
+		  class = typename EE::is_transparent>
+	const_iterator find(const Q &key) const
+	{
+		return const_iterator(this, findIndex(key));
+	}
+
+	size_t count(const K &key) const
+	{
+		return findIndex(key) != npos() ? 1 : 0;
+	}
+
+	template <class Q, class HH = H, class EE = KeyEqual,
+		  class = typename HH::is_transparent,
+		  class = typename EE::is_transparent>
+	size_t count(const Q &key) const
+	{
+		return findIndex(key) != npos() ? 1 : 0;
+	}
+
+	/**
+	 * @brief Remove an entry
+	 * @return number of entries removed
+	 */
+	size_t erase(const K &key)
+	{
+		size_t idx = findIndex(key);
+		if (idx == npos())
+			return 0;
+		eraseIndex(idx);
+		return 1;
+	}
+
+	template <class Q, class HH = H, class EE = KeyEqual,
+		  class = typename HH::is_transparent,
+		  class = typename EE::is_transparent>
+	size_t erase(const Q &key)
+	{
+		size_t idx = findIndex(key);
+		if (idx == npos())
+			return 0;
+		eraseIndex(idx);
+		return 1;
+	}
+
+	/**
+	 * @brief Remove the entry of an iterator, all iterators are
+	 * invalidated
+	 */
+	void erase(iterator it)
+	{
+		eraseIndex(it.mIdx);
+	}
+
+	void erase(const_iterator it)
+	{
+		eraseIndex(it.mIdx);
+	}
+
+	iterator begin()
+	{
+		return iterator(this, mSlots ? 0 : npos());
+	}
+
+	iterator end()
+	{
+		return iterator(this, npos());
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(this, mSlots ? 0 : npos());
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(this, npos());
+	}
+};
+
+} // futils
@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file heap.h
+ *
+ * @brief intrusive 4-ary min-heap
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_HEAP_H_
+#define _FUTILS_HEAP_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <futils/list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* index of a node which is not in a heap */
+#define FUTILS_HEAP_NO_INDEX UINT32_MAX
+
+/**
+ * heap node, embedded in queued objects like struct list_node
+ */
+struct futils_heap_node {
+	uint64_t key;		/* priority, used when heap has no compare */
+	uint32_t index;		/* position in heap array */
+};
+
+/**
+ * compare two nodes
+ * @return negative if a must be popped before b, 0 if equal, positive if
+ * a must be popped after b
+ */
+typedef int (*futils_heap_cmp_t)(const struct futils_heap_node *a,
+				 const struct futils_heap_node *b);
+
+/* heap array entry, key copy avoids dereferencing nodes when comparing */
+struct futils_heap_item {
+	uint64_t key;
+	struct futils_heap_node *node;
+};
+
+/**
+ * Intrusive 4-ary min-heap.
+ *
+ * Nodes are referenced from a single array where the 4 children of an item
+ * are adjacent, so a sift down compares items of one or two cache lines per
+ * level, and the tree is half as deep as a binary heap. Each node stores its
+ * index in the array, which allows O(log n) removal or update of any node.
+ *
+ * Nodes are ordered by their uint64_t key, or by a compare function given
+ * at init.
+ */
+struct futils_heap {
+	struct futils_heap_item *items;	/* heap array */
+	uint32_t count;			/* number of nodes */
+	uint32_t size;			/* array size */
+	futils_heap_cmp_t cmp;		/* optional compare function */
+};
+
+/**
+ * get the structure containing a heap node
+ *
+ * @param ptr the node pointer.
+ * @param type the type of the container struct this is embedded in.
+ * @param member the name of the node within the struct.
+ */
+#define futils_heap_entry(ptr, type, member) \
+	FUTILS_CONTAINER_OF(ptr, type, member)
+
+/**
+ * initialize a heap
+ * @param heap heap
+ * @param size expected number of nodes, the array grows when needed
+ * @param cmp compare function, NULL to compare node keys
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_heap_init(struct futils_heap *heap, size_t size,
+		     futils_heap_cmp_t cmp);
+
+/**
+ * destroy a heap, nodes are left untouched
+ * @param heap heap
+ * @return 0 on success
+ */
+int futils_heap_destroy(struct futils_heap *heap);
+
+/**
+ * initialize a node
+ * @param node node
+ * @param key node key, unused if heap has a compare function
+ */
+static inline void futils_heap_node_init(struct futils_heap_node *node,
+					 uint64_t key)
+{
+	node->key = key;
+	node->index = FUTILS_HEAP_NO_INDEX;
+}
+
+/**
+ * check if a node is in a heap
+ * @param node initialized node
+ * @return 1 if node is in a heap
+ */
+static inline int futils_heap_node_is_queued(
+		const struct futils_heap_node *node)
+{
+	return node->index != FUTILS_HEAP_NO_INDEX;
+}
+
+/**
+ * get the number of nodes in heap
+ */
+static inline uint32_t futils_heap_count(const struct futils_heap *heap)
+{
+	return heap->count;
+}
+
+/**
+ * get the first node of heap without removing it
+ * @param heap heap
+ * @return smallest node, NULL if heap is empty
+ */
+static inline struct futils_heap_node *
+futils_heap_top(const struct futils_heap *heap)
+{
+	return heap->count > 0 ? heap->items[0].node : NULL;
+}
+
+/**
+ * insert a node in heap
+ * @param heap heap
+ * @param node initialized node, not in a heap
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_heap_push(struct futils_heap *heap, struct futils_heap_node *node);
+
+/**
+ * remove the first node of heap
+ * @param heap heap
+ * @return smallest node, NULL if heap is empty
+ */
+struct futils_heap_node *futils_heap_pop(struct futils_heap *heap);
+
+/**
+ * remove a node from heap
+ * @param heap heap
+ * @param node node in heap
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_heap_remove(struct futils_heap *heap,
+		       struct futils_heap_node *node);
+
+/**
+ * restore heap order after a change of a node key (or of the fields used
+ * by the compare function)
+ * @param heap heap
+ * @param node node in heap
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_heap_update(struct futils_heap *heap,
+		       struct futils_heap_node *node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_HEAP_H_*/
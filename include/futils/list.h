@@ -263,6 +263,141 @@ list_length(const struct list_node *list)
 	return length;
 }
 
+/* sorting helpers */
+
+/**
+ * list nodes compare function
+ * @param priv private data given to list_sort() or list_merge()
+ * @return negative if a must be before b, 0 if equal, positive if a must
+ * be after b
+ */
+typedef int (*list_cmp_func_t)(void *priv, const struct list_node *a,
+			       const struct list_node *b);
+
+/* maximum number of pending runs, enough to sort 2^32 nodes in balance */
+#define LIST_SORT_MAX_LEVELS 32
+
+/* merge two sorted NULL terminated chains linked by next only */
+static inline struct list_node *
+list_sort_merge_chains(struct list_node *a, struct list_node *b,
+		       list_cmp_func_t cmp, void *priv)
+{
+	struct list_node head;
+	struct list_node *tail = &head;
+
+	while (a && b) {
+		/* take from a on equality, to keep sort stable */
+		if (cmp(priv, a, b) <= 0) {
+			tail->next = a;
+			a = a->next;
+		} else {
+			tail->next = b;
+			b = b->next;
+		}
+		tail = tail->next;
+	}
+	tail->next = a ? a : b;
+
+	return head.next;
+}
+
+/**
+ * sort a list in place
+ *
+ * Bottom-up merge sort working on the list links: O(n log n) compares,
+ * stable, and no memory allocation.
+ *
+ * @param list list head
+ * @param cmp compare function
+ * @param priv private data given to cmp
+ */
+static inline void
+list_sort(struct list_node *list, list_cmp_func_t cmp, void *priv)
+{
+	struct list_node *part[LIST_SORT_MAX_LEVELS + 1];
+	struct list_node *cur, *next, *prev;
+	int lev, max_lev = 0;
+
+	if (list->next == list->prev)
+		return;
+
+	for (lev = 0; lev <= LIST_SORT_MAX_LEVELS; lev++)
+		part[lev] = NULL;
+
+	/* part[n] is a sorted run of 2^n nodes, older nodes at higher n */
+	list->prev->next = NULL;
+	next = list->next;
+	while (next) {
+		cur = next;
+		next = next->next;
+		cur->next = NULL;
+
+		for (lev = 0; part[lev]; lev++) {
+			cur = list_sort_merge_chains(part[lev], cur, cmp, priv);
+			part[lev] = NULL;
+		}
+		if (lev > max_lev) {
+			if (lev >= LIST_SORT_MAX_LEVELS)
+				lev--;
+			max_lev = lev;
+		}
+		part[lev] = cur;
+	}
+
+	cur = NULL;
+	for (lev = 0; lev <= max_lev; lev++) {
+		if (part[lev])
+			cur = list_sort_merge_chains(part[lev], cur, cmp, priv);
+	}
+
+	/* restore prev links */
+	prev = list;
+	for (; cur; cur = cur->next) {
+		prev->next = cur;
+		cur->prev = prev;
+		prev = cur;
+	}
+	prev->next = list;
+	list->prev = prev;
+}
+
+/**
+ * merge a sorted list into another sorted list
+ *
+ * Nodes of other are moved into list, after nodes of list comparing equal.
+ * other is empty on return.
+ *
+ * @param list sorted list head, receives all nodes
+ * @param other sorted list head
+ * @param cmp compare function
+ * @param priv private data given to cmp
+ */
+static inline void
+list_merge(struct list_node *list, struct list_node *other,
+	   list_cmp_func_t cmp, void *priv)
+{
+	struct list_node *pos = list->next;
+	struct list_node *node;
+
+	while (!list_is_empty(other)) {
+		node = other->next;
+		while (pos != list && cmp(priv, pos, node) <= 0)
+			pos = pos->next;
+
+		if (pos == list) {
+			/* append the remaining nodes at once */
+			other->next->prev = list->prev;
+			list->prev->next = other->next;
+			other->prev->next = list;
+			list->prev = other->prev;
+			list_init(other);
+			break;
+		}
+
+		list_move_before(pos, node);
+	}
+}
+
 /* list-as-fifo helpers */
 
 /* Push one element into the list */
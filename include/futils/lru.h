@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file lru.h
+ *
+ * @brief bounded least recently used cache
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_LRU_H_
+#define _FUTILS_LRU_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Cache of values indexed by uint32_t keys, bounded in number of entries
+ * and/or in bytes. Lookups and updates are O(1): entries are indexed by a
+ * struct hash and ordered by recency in a list, the least recently used
+ * entries being evicted first when a limit is exceeded.
+ */
+struct futils_lru;
+
+/**
+ * lru statistics
+ */
+struct futils_lru_stats {
+	uint64_t hits;		/* number of successful futils_lru_get() */
+	uint64_t misses;	/* number of failed futils_lru_get() */
+	uint64_t evictions;	/* number of entries evicted by limits */
+	size_t entries;		/* current number of entries */
+	size_t bytes;		/* current sum of entries sizes */
+};
+
+/**
+ * @brief Create a cache
+ *
+ * @param[in] max_entries Maximum number of entries, 0 for no limit
+ * @param[in] max_bytes Maximum sum of entries sizes, 0 for no limit
+ * @param[in] release Function called for each value leaving the cache
+ *     (evicted, erased, replaced or destroyed), can be NULL
+ * @param[in] userdata Data passed to release function
+ *
+ * @return Handle for future uses on success
+ *         NULL on error
+ */
+struct futils_lru *futils_lru_new(size_t max_entries, size_t max_bytes,
+		void (*release)(uint32_t key, void *value, void *userdata),
+		void *userdata);
+
+/**
+ * @brief Destroy a cache, releasing all its values
+ *
+ * @param[in] lru Handle of the cache
+ */
+void futils_lru_destroy(struct futils_lru *lru);
+
+/**
+ * @brief Add or replace a value in the cache
+ *
+ * The entry becomes the most recently used one, and least recently used
+ * entries are evicted until the cache fits its limits again.
+ *
+ * @param[in] lru Handle of the cache
+ * @param[in] key Key of the value
+ * @param[in] value Value to store
+ * @param[in] size Size of the value, accounted in the bytes limit
+ *
+ * @return 0 on success,
+ *         -E2BIG if size is larger than the bytes limit,
+ *         negative errno on error
+ */
+int futils_lru_put(struct futils_lru *lru, uint32_t key, void *value,
+		   size_t size);
+
+/**
+ * @brief Get a value from the cache and mark it as most recently used
+ *
+ * @param[in] lru Handle of the cache
+ * @param[in] key Key of the value
+ * @param[out] value The value if found
+ *
+ * @return 0 on success,
+ *         -ENOENT if key is not in the cache,
+ *         negative errno on error
+ */
+int futils_lru_get(struct futils_lru *lru, uint32_t key, void **value);
+
+/**
+ * @brief Remove a value from the cache, releasing it
+ *
+ * @param[in] lru Handle of the cache
+ * @param[in] key Key of the value
+ *
+ * @return 0 on success,
+ *         -ENOENT if key is not in the cache,
+ *         negative errno on error
+ */
+int futils_lru_erase(struct futils_lru *lru, uint32_t key);
+
+/**
+ * @brief Remove all values from the cache, releasing them
+ *
+ * @param[in] lru Handle of the cache
+ *
+ * @return 0 on success,
+ *         negative errno on error
+ */
+int futils_lru_clear(struct futils_lru *lru);
+
+/**
+ * @brief Get cache statistics
+ *
+ * @param[in] lru Handle of the cache
+ * @param[out] stats Statistics
+ *
+ * @return 0 on success,
+ *         negative errno on error
+ */
+int futils_lru_get_stats(const struct futils_lru *lru,
+			 struct futils_lru_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FUTILS_LRU_H_ */
@@ -51,6 +51,26 @@ struct mbox;
  */
 struct mbox *mbox_new(size_t msg_size);
 
+/**
+ * @brief Create a mail box keeping messages in a userspace ring
+ *
+ * Messages are copied once in a ring buffer protected by a mutex, and the
+ * read fd (an eventfd on Linux, a pipe elsewhere) is only used for wakeups:
+ * it becomes readable when the first message is queued and is drained when
+ * the last one is read, so it is readable exactly while messages are queued.
+ * Wakeups thus cost no system call only while a backlog is queued: when each
+ * message is read before the next one is pushed, every message still costs
+ * a write and a read of the wakeup fd.
+ * Messages are not limited to PIPE_BUF bytes. Not supported on Windows.
+ *
+ * @param[in] msg_size The size of a message, must be greater than 0
+ * @param[in] capacity The maximum number of queued messages
+ *
+ * @return Handle for future uses on success
+ *         NULL on error
+ */
+struct mbox *mbox_new_ring(size_t msg_size, size_t capacity);
+
 /**
  * @brief Destroy a mail box
  *
@@ -79,6 +99,23 @@ int mbox_get_read_fd(const struct mbox *box);
  */
 int mbox_push(struct mbox *box, const void *msg);
 
+/**
+ * @brief Write several messages in the mail box
+ *
+ * Messages are written with as few system calls as possible, each of them
+ * queuing only whole messages.
+ *
+ * @param[in] box Handle of the mail box
+ * @param[in] msgs Array of n messages of the mail box message size
+ * @param[in] n Number of messages to send
+ *
+ * @return number of messages written, possibly less than n if the mail box
+ *         is full,
+ *         -EAGAIN if the mail box is full,
+ *         negative errno on error
+ */
+int mbox_push_batch(struct mbox *box, const void *msgs, size_t n);
+
 /**
  * @brief Write a message in the mail box, blocking until message is queued
  * or a timeout expires
@@ -109,6 +146,22 @@ int mbox_push_block(struct mbox *box, const void *msg,
  */
 int mbox_peek(struct mbox *box, void *msg);
 
+/**
+ * @brief read several messages from the mail box
+ *
+ * All queued messages, up to max, are read with a single system call.
+ * The read fd stays readable as long as messages remain queued.
+ *
+ * @param[in] box Handle of the mail box
+ * @param[out] msgs Array of max messages of the mail box message size
+ * @param[in] max Maximum number of messages to read
+ *
+ * @return number of messages read,
+ *         -EAGAIN if no message is queued,
+ *         negative errno on error
+ */
+int mbox_peek_batch(struct mbox *box, void *msgs, size_t max);
+
 #ifdef __cplusplus
 }
 #endif
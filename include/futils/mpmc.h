@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file mpmc.h
+ *
+ * @brief bounded multi producer multi consumer queue
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_MPMC_H_
+#define _FUTILS_MPMC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bounded multi producer multi consumer queue of fixed size elements.
+ *
+ * Elements are copied in a ring of cells, each cell carrying a sequence
+ * number telling whether it can be written or read for the current lap
+ * (Vyukov algorithm). A push or a pop only does one compare and swap on the
+ * shared enqueue or dequeue position, so producers and consumers do not
+ * serialize on a lock.
+ *
+ * Blocking variants use a mutex and condition variables only when the
+ * queue is full or empty; the fast path checks an atomic waiters counter
+ * and does not touch them when nobody waits.
+ */
+struct futils_mpmc;
+
+/**
+ * create a new queue
+ * @param elem_size size of elements
+ * @param size maximum number of elements, rounded up to a power of two
+ * @return queue on success, NULL on error
+ */
+struct futils_mpmc *futils_mpmc_new(size_t elem_size, size_t size);
+
+/**
+ * destroy a queue, no thread must be using it anymore
+ * @param q queue
+ */
+void futils_mpmc_destroy(struct futils_mpmc *q);
+
+/**
+ * push an element without blocking
+ * @param q queue
+ * @param elem element to copy
+ * @return 0 on success, -EAGAIN if queue is full, negative errno value on
+ * other errors
+ */
+int futils_mpmc_try_push(struct futils_mpmc *q, const void *elem);
+
+/**
+ * pop the oldest element without blocking
+ * @param q queue
+ * @param elem copy of popped element
+ * @return 0 on success, -EAGAIN if queue is empty, negative errno value on
+ * other errors
+ */
+int futils_mpmc_try_pop(struct futils_mpmc *q, void *elem);
+
+/**
+ * push an element, blocking while queue is full
+ * @param q queue
+ * @param elem element to copy
+ * @param timeout_ms timeout in milliseconds, 0 for infinity
+ * @return 0 on success, -ETIMEDOUT on timeout, negative errno value on
+ * other errors
+ */
+int futils_mpmc_push_block(struct futils_mpmc *q, const void *elem,
+			   unsigned int timeout_ms);
+
+/**
+ * pop the oldest element, blocking while queue is empty
+ * @param q queue
+ * @param elem copy of popped element
+ * @param timeout_ms timeout in milliseconds, 0 for infinity
+ * @return 0 on success, -ETIMEDOUT on timeout, negative errno value on
+ * other errors
+ */
+int futils_mpmc_pop_block(struct futils_mpmc *q, void *elem,
+			  unsigned int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_MPMC_H_*/
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file mpscq.h
+ *
+ * @brief intrusive lock free multi producer single consumer queue
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_MPSCQ_H_
+#define _FUTILS_MPSCQ_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <futils/list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FUTILS_MPSCQ_CACHE_LINE 64
+
+/**
+ * mpsc queue node, embedded in queued objects like struct list_node
+ */
+struct futils_mpscq_node {
+	struct futils_mpscq_node *next;
+};
+
+/**
+ * Intrusive multi producer single consumer queue (Vyukov algorithm).
+ *
+ * Any thread can push without lock with a single atomic exchange, only one
+ * thread at a time may pop. Objects are handed over by pointer, without copy
+ * nor system call; waking up the consumer is left to the caller.
+ */
+struct futils_mpscq {
+	/* last pushed node, written by producers */
+	struct futils_mpscq_node *head;
+	/* keep producers and consumer on different cache lines */
+	char pad[FUTILS_MPSCQ_CACHE_LINE - sizeof(void *)];
+	/* next node to pop, only used by consumer */
+	struct futils_mpscq_node *tail;
+	/* dummy node, keeps the queue never empty for producers */
+	struct futils_mpscq_node stub;
+};
+
+/**
+ * get the structure containing a queue node
+ *
+ * @param ptr the node pointer.
+ * @param type the type of the container struct this is embedded in.
+ * @param member the name of the node within the struct.
+ */
+#define futils_mpscq_entry(ptr, type, member) \
+	FUTILS_CONTAINER_OF(ptr, type, member)
+
+/**
+ * initialize an empty queue
+ * @param q queue
+ */
+static inline void futils_mpscq_init(struct futils_mpscq *q)
+{
+	q->stub.next = NULL;
+	q->tail = &q->stub;
+	__atomic_store_n(&q->head, &q->stub, __ATOMIC_RELEASE);
+}
+
+/**
+ * push a node in queue, can be called from any thread
+ * @param q queue
+ * @param node node to push, must not be already queued
+ */
+static inline void futils_mpscq_push(struct futils_mpscq *q,
+				     struct futils_mpscq_node *node)
+{
+	struct futils_mpscq_node *prev;
+
+	__atomic_store_n(&node->next, NULL, __ATOMIC_RELAXED);
+	prev = __atomic_exchange_n(&q->head, node, __ATOMIC_ACQ_REL);
+	/* consumer cannot go past prev until this store is done */
+	__atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+}
+
+/**
+ * pop the oldest node from queue, must be called from a single consumer
+ *
+ * A push being done by another thread is not visible until it completes,
+ * so NULL may be returned while the queue is not empty: nodes pushed after
+ * an incomplete push are then returned by a later call.
+ *
+ * @param q queue
+ * @return popped node, NULL if there is no node to pop
+ */
+static inline struct futils_mpscq_node *
+futils_mpscq_pop(struct futils_mpscq *q)
+{
+	struct futils_mpscq_node *tail = q->tail;
+	struct futils_mpscq_node *next;
+
+	next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+	/* skip stub node */
+	if (tail == &q->stub) {
+		if (!next)
+			return NULL;
+		q->tail = next;
+		tail = next;
+		next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+	}
+
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
+
+	/* a push is in progress after tail */
+	if (tail != __atomic_load_n(&q->head, __ATOMIC_ACQUIRE))
+		return NULL;
+
+	/* tail is the last node: push back stub to be able to pop it */
+	futils_mpscq_push(q, &q->stub);
+	next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
+
+	return NULL;
+}
+
+/**
+ * check if queue is empty, must be called from the consumer
+ * @param q queue
+ * @return 1 if there is no node to pop
+ */
+static inline int futils_mpscq_is_empty(struct futils_mpscq *q)
+{
+	return q->tail == &q->stub &&
+	       __atomic_load_n(&q->stub.next, __ATOMIC_ACQUIRE) == NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_MPSCQ_H_*/
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file phash.h
+ *
+ * @brief immutable minimal perfect hash table
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_PHASH_H_
+#define _FUTILS_PHASH_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <futils/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * perfect hash slot
+ */
+struct futils_phash_slot {
+	uint32_t key;			/* slot key */
+	uint32_t is_const;		/* is entry const */
+	union {
+		void *data;		/* entry data */
+		const void *const_data;	/* entry const data */
+	};
+};
+
+/**
+ * immutable minimal perfect hash table
+ *
+ * Keys are split in buckets, each bucket having a displacement chosen at
+ * build time so that all keys land in distinct slots (hash and displace).
+ * A lookup reads one displacement and one slot, and compares one key.
+ *
+ * Only plain arrays are referenced, so a table can also be generated
+ * offline and declared as static const data, in which case
+ * futils_phash_destroy() must not be called on it.
+ */
+struct futils_phash {
+	const uint32_t *disp;			/* bucket displacements */
+	const struct futils_phash_slot *slots;	/* table slots */
+	uint32_t nbuckets;			/* number of buckets */
+	uint32_t count;				/* number of slots/entries */
+	uint32_t seed;				/* bucket hash seed */
+};
+
+/**
+ * build a perfect hash table from the entries of a hash table
+ *
+ * Entries data pointers are copied, not owned: they must remain valid as
+ * long as the perfect hash table is used. Tables with entries linked by
+ * futils_hash_link() are not supported.
+ *
+ * @param phash perfect hash table
+ * @param hash source hash table
+ * @return 0 on success, -EINVAL if the table has intrusive entries, -EAGAIN
+ * if no perfect hash function was found
+ */
+int futils_phash_build(struct futils_phash *phash, const struct hash *hash);
+
+/**
+ * destroy a perfect hash table built with futils_phash_build()
+ * @param phash
+ * @return 0 on success
+ */
+int futils_phash_destroy(struct futils_phash *phash);
+
+/**
+ * lookup to an entry in perfect hash table
+ *
+ * @param phash perfect hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found, -EPERM if entry is const
+ */
+int futils_phash_lookup(const struct futils_phash *phash, uint32_t key,
+			void **data);
+
+/**
+ * lookup to a const entry in perfect hash table
+ *
+ * @param phash perfect hash table
+ * @param key entry key
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found
+ */
+int futils_phash_lookup_const(const struct futils_phash *phash, uint32_t key,
+			      const void **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_PHASH_H_*/
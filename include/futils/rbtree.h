@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file rbtree.h
+ *
+ * @brief intrusive red-black tree
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_RBTREE_H_
+#define _FUTILS_RBTREE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <futils/list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * red-black tree node, embedded in sorted objects like struct list_node
+ */
+struct futils_rbnode {
+	struct futils_rbnode *parent;
+	struct futils_rbnode *left;
+	struct futils_rbnode *right;
+	int red;
+};
+
+/**
+ * Intrusive red-black tree.
+ *
+ * Nodes are sorted by a compare function given on insert, insertion, removal
+ * and lookups are O(log n) and never allocate. Nodes with equal keys are
+ * kept in insertion order.
+ */
+struct futils_rbtree {
+	struct futils_rbnode *root;
+};
+
+/**
+ * compare two nodes
+ * @return negative if a is before b, 0 if equal, positive if a is after b
+ */
+typedef int (*futils_rbtree_cmp_t)(const struct futils_rbnode *a,
+				   const struct futils_rbnode *b);
+
+/**
+ * compare a node with a key
+ * @return negative if node is before key, 0 if equal, positive if node is
+ * after key
+ */
+typedef int (*futils_rbtree_key_cmp_t)(const struct futils_rbnode *node,
+				       const void *key);
+
+/**
+ * get the structure containing a tree node
+ *
+ * @param ptr the node pointer.
+ * @param type the type of the container struct this is embedded in.
+ * @param member the name of the node within the struct.
+ */
+#define futils_rbtree_entry(ptr, type, member) \
+	FUTILS_CONTAINER_OF(ptr, type, member)
+
+static inline void futils_rbtree_init(struct futils_rbtree *tree)
+{
+	tree->root = NULL;
+}
+
+static inline int futils_rbtree_is_empty(const struct futils_rbtree *tree)
+{
+	return tree->root == NULL;
+}
+
+/**
+ * insert a node in tree, after nodes with an equal key
+ * @param tree tree
+ * @param node node to insert, must not be already in a tree
+ * @param cmp nodes compare function
+ */
+void futils_rbtree_insert(struct futils_rbtree *tree,
+			  struct futils_rbnode *node, futils_rbtree_cmp_t cmp);
+
+/**
+ * remove a node from tree
+ * @param tree tree
+ * @param node node in tree
+ */
+void futils_rbtree_erase(struct futils_rbtree *tree,
+			 struct futils_rbnode *node);
+
+/**
+ * find the first node not before a key
+ * @param tree tree
+ * @param cmp node and key compare function
+ * @param key key
+ * @return first node whose key is greater or equal, NULL if none
+ */
+struct futils_rbnode *futils_rbtree_lower_bound(
+		const struct futils_rbtree *tree, futils_rbtree_key_cmp_t cmp,
+		const void *key);
+
+/**
+ * find the first node with a key
+ * @param tree tree
+ * @param cmp node and key compare function
+ * @param key key
+ * @return first node with an equal key, NULL if none
+ */
+struct futils_rbnode *futils_rbtree_find(const struct futils_rbtree *tree,
+					 futils_rbtree_key_cmp_t cmp,
+					 const void *key);
+
+/**
+ * get first (smallest) node of tree
+ * @return first node, NULL if tree is empty
+ */
+struct futils_rbnode *futils_rbtree_first(const struct futils_rbtree *tree);
+
+/**
+ * get last (greatest) node of tree
+ * @return last node, NULL if tree is empty
+ */
+struct futils_rbnode *futils_rbtree_last(const struct futils_rbtree *tree);
+
+/**
+ * get node following a node in tree order
+ * @return next node, NULL if node is the last one
+ */
+struct futils_rbnode *futils_rbtree_next(const struct futils_rbnode *node);
+
+/**
+ * get node preceding a node in tree order
+ * @return previous node, NULL if node is the first one
+ */
+struct futils_rbnode *futils_rbtree_prev(const struct futils_rbnode *node);
+
+/**
+ * walk tree nodes in order, the current node must not be removed
+ * @param tree tree
+ * @param pos struct futils_rbnode pointer used as cursor
+ */
+#define futils_rbtree_walk_forward(tree, pos) \
+	for (pos = futils_rbtree_first(tree); pos; \
+	     pos = futils_rbtree_next(pos))
+
+/**
+ * walk tree nodes in order, the current node can be removed
+ * @param tree tree
+ * @param pos struct futils_rbnode pointer used as cursor
+ * @param tmp struct futils_rbnode pointer used as temporary storage
+ */
+#define futils_rbtree_walk_forward_safe(tree, pos, tmp) \
+	for (pos = futils_rbtree_first(tree), \
+	     tmp = pos ? futils_rbtree_next(pos) : NULL; pos; \
+	     pos = tmp, tmp = pos ? futils_rbtree_next(pos) : NULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_RBTREE_H_*/
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file slotmap.h
+ *
+ * @brief generational slot map
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_SLOTMAP_H_
+#define _FUTILS_SLOTMAP_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* handle never returned by a slot map */
+#define FUTILS_SLOTMAP_INVALID_HANDLE UINT64_C(0)
+
+/**
+ * Generational slot map.
+ *
+ * Elements of a fixed size are stored contiguously and referenced by 64bit
+ * handles made of a slot index and a generation counter. Getting an element
+ * from its handle is O(1) without hashing, and a handle of a removed
+ * element is rejected even if its slot has been reused.
+ *
+ * Removing an element moves the last element in its place, so that live
+ * elements always form a dense array that can be iterated directly.
+ * Element pointers are invalidated by any insertion or removal, handles
+ * are not.
+ */
+struct futils_slotmap;
+
+/**
+ * create a new slot map
+ * @param elem_size size of elements
+ * @param size expected number of elements, the map grows when needed
+ * @return slot map on success, NULL on error
+ */
+struct futils_slotmap *futils_slotmap_new(size_t elem_size, size_t size);
+
+/**
+ * destroy slot map
+ * @param map
+ */
+void futils_slotmap_destroy(struct futils_slotmap *map);
+
+/**
+ * insert an element in slot map
+ * @param map slot map
+ * @param elem element to copy, NULL to zero the new element
+ * @param handle element handle
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_slotmap_insert(struct futils_slotmap *map, const void *elem,
+			  uint64_t *handle);
+
+/**
+ * remove an element from slot map
+ * @param map slot map
+ * @param handle element handle
+ * @return 0 on success, -ENOENT if handle is invalid or stale
+ */
+int futils_slotmap_remove(struct futils_slotmap *map, uint64_t handle);
+
+/**
+ * remove all elements from slot map, all handles become stale
+ * @param map slot map
+ * @return 0 on success
+ */
+int futils_slotmap_clear(struct futils_slotmap *map);
+
+/**
+ * get an element from its handle
+ * @param map slot map
+ * @param handle element handle
+ * @return element pointer, NULL if handle is invalid or stale
+ */
+void *futils_slotmap_get(const struct futils_slotmap *map, uint64_t handle);
+
+/**
+ * get the number of elements
+ * @param map slot map
+ * @return number of elements
+ */
+size_t futils_slotmap_count(const struct futils_slotmap *map);
+
+/**
+ * get the dense array of elements, of futils_slotmap_count() elements
+ * @param map slot map
+ * @return first element, NULL if map is empty
+ */
+void *futils_slotmap_data(const struct futils_slotmap *map);
+
+/**
+ * get the handle of an element of the dense array
+ * @param map slot map
+ * @param idx element index in dense array
+ * @return element handle, FUTILS_SLOTMAP_INVALID_HANDLE if out of range
+ */
+uint64_t futils_slotmap_handle_at(const struct futils_slotmap *map,
+				  size_t idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_SLOTMAP_H_*/
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file spsc.h
+ *
+ * @brief single producer single consumer ring
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_SPSC_H_
+#define _FUTILS_SPSC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* create a notification fd, see futils_spsc_prepare_wait() */
+#define FUTILS_SPSC_FLAG_NOTIFY 0x1
+
+/**
+ * Wait-free single producer single consumer ring.
+ *
+ * Records are copied in a ring buffer without lock nor system call: one
+ * thread pushes, one thread pops, and each side only writes its own index.
+ * Producer and consumer indexes live on separate cache lines, and each side
+ * keeps a cached copy of the other side index, refreshed only when the ring
+ * looks full (producer) or empty (consumer).
+ *
+ * Records are either all of a fixed size, or of variable size with a small
+ * header, records never being split across the ring end.
+ *
+ * With FUTILS_SPSC_FLAG_NOTIFY, a consumer that wants to sleep calls
+ * futils_spsc_prepare_wait() then polls the fd returned by
+ * futils_spsc_get_fd(). The producer only signals the fd when the consumer
+ * is parked this way, so pushes to a busy consumer cost no system call.
+ */
+struct futils_spsc;
+
+/**
+ * create a new ring
+ * @param size number of records for fixed size records, number of bytes for
+ * variable size records; rounded up to a power of two
+ * @param record_size size of records, 0 for variable size records
+ * @param flags FUTILS_SPSC_FLAG_xxx
+ * @return ring on success, NULL on error
+ */
+struct futils_spsc *futils_spsc_new(size_t size, size_t record_size,
+				    int flags);
+
+/**
+ * destroy a ring
+ * @param spsc ring
+ */
+void futils_spsc_destroy(struct futils_spsc *spsc);
+
+/**
+ * get the maximum size of a record
+ * @param spsc ring
+ * @return maximum record size, negative errno value on errors
+ */
+ssize_t futils_spsc_get_max_size(const struct futils_spsc *spsc);
+
+/**
+ * push a record, producer side
+ * @param spsc ring
+ * @param record record to copy
+ * @param len record size, must be the ring record size for fixed size
+ * records
+ * @return 0 on success, -EAGAIN if ring is full, negative errno value on
+ * other errors
+ */
+int futils_spsc_push(struct futils_spsc *spsc, const void *record, size_t len);
+
+/**
+ * pop the oldest record, consumer side
+ * @param spsc ring
+ * @param record buffer for the record
+ * @param len size of buffer
+ * @return record size on success, -EAGAIN if ring is empty, -ENOBUFS if
+ * buffer is too small (record is left in ring), negative errno value on
+ * other errors
+ */
+ssize_t futils_spsc_pop(struct futils_spsc *spsc, void *record, size_t len);
+
+/**
+ * check if ring is empty, consumer side
+ * @param spsc ring
+ * @return 1 if empty, 0 if not
+ */
+int futils_spsc_is_empty(struct futils_spsc *spsc);
+
+/**
+ * get the notification fd, readable after the producer pushed a record
+ * while the consumer was parked
+ * @param spsc ring
+ * @return fd, -1 if ring was not created with FUTILS_SPSC_FLAG_NOTIFY
+ */
+int futils_spsc_get_fd(const struct futils_spsc *spsc);
+
+/**
+ * park consumer before waiting on the notification fd, consumer side
+ *
+ * Clears pending notifications and marks the consumer parked, so that the
+ * next push signals the fd. The ring is checked again afterwards: if it is
+ * not empty the consumer is not parked and must pop records instead of
+ * waiting. A notification may be spurious, the consumer then finds the ring
+ * empty and parks again.
+ *
+ * @param spsc ring
+ * @return 0 if the consumer may wait on the fd, -EAGAIN if records are
+ * available, negative errno value on other errors
+ */
+int futils_spsc_prepare_wait(struct futils_spsc *spsc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_SPSC_H_*/
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file strhash.h
+ *
+ * @brief hash table with variable length keys
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_STRHASH_H_
+#define _FUTILS_STRHASH_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <futils/hash.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * store keys in an arena owned by the table instead of allocating each key
+ * separately; memory of removed keys is only released by
+ * futils_strhash_remove_all() or futils_strhash_destroy()
+ *
+ * The arena is never compacted: with repeated insertions and removals its
+ * size grows without bound, even if the number of entries stays constant.
+ * Only use it for tables that are filled then mostly looked up, or that are
+ * periodically cleared.
+ */
+#define FUTILS_STRHASH_ARENA (1 << 0)
+
+struct futils_strhash_chunk;
+
+/**
+ * strhash slot, stored inline in the table
+ */
+struct futils_strhash_slot {
+	uint32_t hash;			/* key hash value */
+	uint32_t dib:31;		/* distance to initial bucket + 1,
+					 * 0 if slot is empty */
+	uint32_t is_const:1;		/* is entry const */
+	const void *key;		/* key copy, owned by table */
+	size_t len;			/* key length */
+	union {
+		void *data;		/* entry data */
+		const void *const_data;	/* entry const data */
+	};
+};
+
+/**
+ * strhash structure
+ *
+ * Robin Hood open addressing table keyed by byte strings (C strings or any
+ * binary blob). The hash value of each key is stored in its slot, so key
+ * bytes are only compared when hash values match and the table grows
+ * without hashing keys again.
+ */
+struct futils_strhash {
+	struct futils_strhash_slot *slots;	/* table slots */
+	uint32_t mask;				/* table size - 1 */
+	uint32_t count;				/* number of entries */
+	uint32_t grow_at;			/* count triggering growth */
+	int flags;				/* FUTILS_STRHASH_xxx flags */
+	struct futils_strhash_chunk *arena;	/* key storage chunks */
+	void (*hfree)(void *);		/* allocator free callback */
+};
+
+/**
+ * create a new strhash table
+ * @param hash
+ * @param size expected number of entries, the table grows when needed
+ * @param flags FUTILS_STRHASH_xxx flags
+ * @param hfree allocator free callback, not called for const entries
+ * @return 0 on success
+ */
+int futils_strhash_init(struct futils_strhash *hash, size_t size, int flags,
+			void (*hfree)(void *));
+
+/**
+ * destroy strhash table
+ * @param hash
+ * @return 0 on success
+ */
+int futils_strhash_destroy(struct futils_strhash *hash);
+
+/**
+ * insert an entry in strhash table, key is copied
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param len entry key length
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_strhash_insert(struct futils_strhash *hash, const void *key,
+			  size_t len, void *data);
+
+/**
+ * insert a const entry in strhash table, key is copied
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param len entry key length
+ * @param data entry data to be stored
+ * @return 0 if entry inserted, -EEXIST if another entry with same key.
+ */
+int futils_strhash_insert_const(struct futils_strhash *hash, const void *key,
+				size_t len, const void *data);
+
+/**
+ * remove an entry from strhash table
+ *
+ * @param hash hash table
+ * @param key entry key to be removed
+ * @param len entry key length
+ * @return 0 if entry is found and removed
+ */
+int futils_strhash_remove(struct futils_strhash *hash, const void *key,
+			  size_t len);
+
+/**
+ * remove all entries from strhash table
+ *
+ * @param hash hash table
+ * @return 0 if hash is cleared
+ */
+int futils_strhash_remove_all(struct futils_strhash *hash);
+
+/**
+ * lookup to an entry in strhash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param len entry key length
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found, -EPERM if entry is const
+ */
+int futils_strhash_lookup(const struct futils_strhash *hash, const void *key,
+			  size_t len, void **data);
+
+/**
+ * lookup to a const entry in strhash table
+ *
+ * @param hash hash table
+ * @param key entry key
+ * @param len entry key length
+ * @param data entry data pointer if entry found
+ * @return return 0 if entry is found
+ */
+int futils_strhash_lookup_const(const struct futils_strhash *hash,
+				const void *key, size_t len,
+				const void **data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_STRHASH_H_*/
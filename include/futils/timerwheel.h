@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file timerwheel.h
+ *
+ * @brief hierarchical timer wheel
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_TIMERWHEEL_H_
+#define _FUTILS_TIMERWHEEL_H_
+
+#include <stdint.h>
+#include <futils/list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of slots per level */
+#define FUTILS_TIMERWHEEL_SLOTS 64
+
+/* number of levels, enough to cover 64bit tick values */
+#define FUTILS_TIMERWHEEL_LEVELS 11
+
+struct futils_timer;
+
+/**
+ * timer expiration callback
+ * @param timer expired timer, not armed anymore and can be armed again
+ * @param userdata user data given to futils_timer_init()
+ */
+typedef void (*futils_timer_cb_t)(struct futils_timer *timer, void *userdata);
+
+/**
+ * timer, embedded in user structures or standalone
+ */
+struct futils_timer {
+	struct list_node node;		/* node in wheel slot */
+	uint64_t expire;		/* expiration tick */
+	futils_timer_cb_t cb;		/* expiration callback */
+	void *userdata;			/* callback user data */
+	uint8_t level;			/* wheel level */
+	uint8_t slot;			/* slot in level */
+};
+
+/**
+ * Hierarchical timer wheel.
+ *
+ * Level n has 64 slots of 64^n ticks each, a timer is put in the lowest
+ * level where it fits, and is moved to lower levels as time advances
+ * (cascading). Arming and cancelling a timer are O(1), and per level
+ * occupancy bitmaps allow to skip directly to the next non empty slot.
+ *
+ * Time is the monotonic clock (time_get_monotonic()) in ms, rounded to the
+ * tick resolution given at init: timers never fire early, and fire at most
+ * one tick late after futils_timerwheel_advance() is called.
+ *
+ * A wheel is not thread safe.
+ */
+struct futils_timerwheel {
+	uint64_t now;			/* current tick */
+	uint32_t tick_ms;		/* tick duration */
+	uint32_t count;			/* number of armed timers */
+	uint64_t occupied[FUTILS_TIMERWHEEL_LEVELS];	/* non empty slots */
+	struct list_node slots[FUTILS_TIMERWHEEL_LEVELS]
+			      [FUTILS_TIMERWHEEL_SLOTS];
+};
+
+/**
+ * initialize a timer
+ * @param timer timer
+ * @param cb expiration callback
+ * @param userdata callback user data
+ */
+void futils_timer_init(struct futils_timer *timer, futils_timer_cb_t cb,
+		       void *userdata);
+
+/**
+ * check if a timer is armed
+ * @param timer initialized timer
+ * @return 1 if armed, 0 otherwise
+ */
+int futils_timer_is_armed(const struct futils_timer *timer);
+
+/**
+ * initialize a timer wheel, current time is read from monotonic clock
+ * @param wheel timer wheel
+ * @param tick_ms tick duration in ms
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_timerwheel_init(struct futils_timerwheel *wheel, uint32_t tick_ms);
+
+/**
+ * arm a timer relative to current monotonic time, an armed timer is
+ * re-armed
+ * @param wheel timer wheel
+ * @param timer initialized timer
+ * @param timeout_ms timeout in ms
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_timerwheel_arm(struct futils_timerwheel *wheel,
+			  struct futils_timer *timer, uint32_t timeout_ms);
+
+/**
+ * arm a timer at a monotonic time, an armed timer is re-armed
+ * @param wheel timer wheel
+ * @param timer initialized timer
+ * @param expire_ms expiration monotonic time in ms, a time already passed
+ * expires on next advance
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_timerwheel_arm_at(struct futils_timerwheel *wheel,
+			     struct futils_timer *timer, uint64_t expire_ms);
+
+/**
+ * cancel a timer, nothing is done if it is not armed
+ * @param wheel timer wheel
+ * @param timer initialized timer
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_timerwheel_cancel(struct futils_timerwheel *wheel,
+			     struct futils_timer *timer);
+
+/**
+ * advance wheel to current monotonic time and call expired timers callbacks
+ *
+ * Callbacks may arm and cancel any timer, but must not advance the wheel.
+ *
+ * @param wheel timer wheel
+ * @return number of expired timers, negative errno value on errors
+ */
+int futils_timerwheel_advance(struct futils_timerwheel *wheel);
+
+/**
+ * advance wheel to a monotonic time and call expired timers callbacks
+ * @param wheel timer wheel
+ * @param now_ms monotonic time in ms, ignored if before wheel time
+ * @return number of expired timers, negative errno value on errors
+ */
+int futils_timerwheel_advance_to(struct futils_timerwheel *wheel,
+				 uint64_t now_ms);
+
+/**
+ * get the time of next wheel event
+ *
+ * This is the next expiration, or an earlier time at which timers of higher
+ * levels have to be moved down, so it can be used as a wake up time.
+ *
+ * @param wheel timer wheel
+ * @param expire_ms monotonic time of next event in ms
+ * @return 0 on success, -ENOENT if no timer is armed
+ */
+int futils_timerwheel_next_expiry(const struct futils_timerwheel *wheel,
+				  uint64_t *expire_ms);
+
+/**
+ * get the delay until next wheel event, for use as poll timeout
+ * @param wheel timer wheel
+ * @return delay in ms, 0 if already due, -1 if no timer is armed
+ */
+int futils_timerwheel_get_timeout(const struct futils_timerwheel *wheel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_TIMERWHEEL_H_*/
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file vec.h
+ *
+ * @brief growable array
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_VEC_H_
+#define _FUTILS_VEC_H_
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Growable array of elements of a size given at init.
+ *
+ * Capacity grows geometrically. An optional caller buffer (typically on the
+ * stack or in the owning structure) holds the first elements, so small
+ * arrays never allocate. Element pointers are invalidated when the array
+ * grows, shrinks, or when elements are inserted or erased before them.
+ */
+struct futils_vec {
+	void *data;			/* elements */
+	size_t count;			/* number of elements */
+	size_t capacity;		/* number of allocated elements */
+	size_t elem_size;		/* element size */
+	void *inline_buf;		/* caller buffer, NULL if none */
+	size_t inline_capacity;		/* caller buffer number of elements */
+};
+
+/**
+ * get the elements array as a typed pointer
+ * @param vec vector
+ * @param type element type
+ */
+#define futils_vec_data(vec, type) ((type *)(vec)->data)
+
+/**
+ * initialize a vector
+ * @param vec vector
+ * @param elem_size element size
+ * @param buf caller buffer used until it is full, NULL if none; it must
+ * stay valid until the vector is destroyed
+ * @param buf_count number of elements of caller buffer
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_init(struct futils_vec *vec, size_t elem_size, void *buf,
+		    size_t buf_count);
+
+/**
+ * destroy a vector, freeing allocated memory
+ * @param vec vector
+ * @return 0 on success
+ */
+int futils_vec_destroy(struct futils_vec *vec);
+
+/**
+ * remove all elements, memory is kept
+ * @param vec vector
+ * @return 0 on success
+ */
+int futils_vec_clear(struct futils_vec *vec);
+
+/**
+ * ensure the vector can hold a number of elements without growing
+ * @param vec vector
+ * @param count number of elements
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_reserve(struct futils_vec *vec, size_t count);
+
+/**
+ * reduce memory to the number of elements, going back to the caller buffer
+ * if elements fit in it
+ * @param vec vector
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_shrink(struct futils_vec *vec);
+
+/**
+ * append an element
+ * @param vec vector
+ * @param elem element to copy, NULL to zero the new element; it may be an
+ * element of the vector itself
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_push(struct futils_vec *vec, const void *elem);
+
+/**
+ * remove the last element
+ * @param vec vector
+ * @param elem copy of removed element, can be NULL
+ * @return 0 on success, -ENOENT if vector is empty
+ */
+int futils_vec_pop(struct futils_vec *vec, void *elem);
+
+/**
+ * insert an element, moving following elements
+ * @param vec vector
+ * @param idx position of new element, at most the number of elements
+ * @param elem element to copy, NULL to zero the new element; it may be an
+ * element of the vector itself
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_insert(struct futils_vec *vec, size_t idx, const void *elem);
+
+/**
+ * remove an element, moving following elements to keep order
+ * @param vec vector
+ * @param idx element position
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_erase(struct futils_vec *vec, size_t idx);
+
+/**
+ * remove an element in O(1) by moving the last element in its place
+ * @param vec vector
+ * @param idx element position
+ * @return 0 on success, negative errno value on errors
+ */
+int futils_vec_swap_remove(struct futils_vec *vec, size_t idx);
+
+/**
+ * get an element
+ * @param vec vector
+ * @param idx element position
+ * @return element pointer, NULL if out of range
+ */
+static inline void *futils_vec_get(const struct futils_vec *vec, size_t idx)
+{
+	if (idx >= vec->count)
+		return NULL;
+
+	return (uint8_t *)vec->data + idx * vec->elem_size;
+}
+
+/**
+ * get the number of elements
+ */
+static inline size_t futils_vec_count(const struct futils_vec *vec)
+{
+	return vec->count;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_FUTILS_VEC_H_*/
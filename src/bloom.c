@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file bloom.c
+ *
+ * @brief blocked Bloom filter
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/bloom.h"
+#include "futils/hash.h"
+
+/* block size in bytes, one cache line */
+#define BLOOM_BLOCK_SIZE 64
+
+/* block size in bits */
+#define BLOOM_BLOCK_BITS (BLOOM_BLOCK_SIZE * 8)
+
+/* maximum number of bits set per key */
+#define BLOOM_MAX_K 16
+
+struct bloom_block {
+	uint64_t words[BLOOM_BLOCK_SIZE / sizeof(uint64_t)];
+};
+
+struct futils_bloom {
+	struct bloom_block *blocks;	/* cache line aligned blocks */
+	void *mem;			/* allocated memory */
+	uint32_t nblocks;		/* number of blocks */
+	uint32_t k;			/* number of bits set per key */
+};
+
+static inline struct bloom_block *bloom_block(const struct futils_bloom *bloom,
+					      uint64_t h)
+{
+	uint32_t idx = (uint32_t)(((h >> 32) * bloom->nblocks) >> 32);
+
+	return &bloom->blocks[idx];
+}
+
+/* next bit index in block, from the top bits of a 32bit sequence */
+static inline uint32_t bloom_next_bit(uint32_t *x)
+{
+	*x = *x * 0x9e3779b1U + 1;
+	return *x >> 23;
+}
+
+static void bloom_add(struct futils_bloom *bloom, uint64_t h)
+{
+	struct bloom_block *block = bloom_block(bloom, h);
+	uint32_t x = (uint32_t)h;
+	uint32_t i, bit;
+
+	for (i = 0; i < bloom->k; i++) {
+		bit = bloom_next_bit(&x);
+		block->words[bit / 64] |= UINT64_C(1) << (bit % 64);
+	}
+}
+
+static int bloom_test(const struct futils_bloom *bloom, uint64_t h)
+{
+	const struct bloom_block *block = bloom_block(bloom, h);
+	uint32_t x = (uint32_t)h;
+	uint32_t i, bit;
+
+	for (i = 0; i < bloom->k; i++) {
+		bit = bloom_next_bit(&x);
+		if (!(block->words[bit / 64] & (UINT64_C(1) << (bit % 64))))
+			return 0;
+	}
+
+	return 1;
+}
+
+static inline uint64_t bloom_hash_u32(uint32_t key)
+{
+	uint32_t lo = futils_hash_u32(key);
+
+	return ((uint64_t)futils_hash_u32(lo ^ 0x9e3779b9U) << 32) | lo;
+}
+
+struct futils_bloom *futils_bloom_new(size_t size, uint32_t bits_per_key)
+{
+	struct futils_bloom *bloom;
+	uint64_t nblocks;
+
+	if (bits_per_key == 0)
+		return NULL;
+
+	nblocks = ((uint64_t)size * bits_per_key + BLOOM_BLOCK_BITS - 1) /
+		  BLOOM_BLOCK_BITS;
+	if (nblocks == 0)
+		nblocks = 1;
+	if (nblocks > UINT32_MAX || nblocks > SIZE_MAX / BLOOM_BLOCK_SIZE - 1)
+		return NULL;
+
+	bloom = calloc(1, sizeof(*bloom));
+	if (!bloom)
+		return NULL;
+
+	bloom->mem = malloc((size_t)nblocks * BLOOM_BLOCK_SIZE +
+			    BLOOM_BLOCK_SIZE - 1);
+	if (!bloom->mem) {
+		free(bloom);
+		return NULL;
+	}
+
+	/* align blocks on cache lines */
+	bloom->blocks = (struct bloom_block *)(((uintptr_t)bloom->mem +
+		BLOOM_BLOCK_SIZE - 1) & ~(uintptr_t)(BLOOM_BLOCK_SIZE - 1));
+	bloom->nblocks = (uint32_t)nblocks;
+
+	/* optimal number of bits is bits_per_key * ln(2) */
+	bloom->k = bits_per_key * 69 / 100;
+	if (bloom->k < 1)
+		bloom->k = 1;
+	else if (bloom->k > BLOOM_MAX_K)
+		bloom->k = BLOOM_MAX_K;
+
+	futils_bloom_clear(bloom);
+	return bloom;
+}
+
+void futils_bloom_destroy(struct futils_bloom *bloom)
+{
+	if (!bloom)
+		return;
+
+	free(bloom->mem);
+	free(bloom);
+}
+
+int futils_bloom_clear(struct futils_bloom *bloom)
+{
+	if (!bloom)
+		return -EINVAL;
+
+	memset(bloom->blocks, 0, (size_t)bloom->nblocks * BLOOM_BLOCK_SIZE);
+	return 0;
+}
+
+int futils_bloom_add_u32(struct futils_bloom *bloom, uint32_t key)
+{
+	if (!bloom)
+		return -EINVAL;
+
+	bloom_add(bloom, bloom_hash_u32(key));
+	return 0;
+}
+
+int futils_bloom_test_u32(const struct futils_bloom *bloom, uint32_t key)
+{
+	if (!bloom)
+		return -EINVAL;
+
+	return bloom_test(bloom, bloom_hash_u32(key));
+}
+
+int futils_bloom_add_bytes(struct futils_bloom *bloom, const void *data,
+			   size_t len)
+{
+	if (!bloom || (!data && len > 0))
+		return -EINVAL;
+
+	bloom_add(bloom, futils_hash_bytes(data, len, 0));
+	return 0;
+}
+
+int futils_bloom_test_bytes(const struct futils_bloom *bloom, const void *data,
+			    size_t len)
+{
+	if (!bloom || (!data && len > 0))
+		return -EINVAL;
+
+	return bloom_test(bloom, futils_hash_bytes(data, len, 0));
+}
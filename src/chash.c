@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file chash.c
+ *
+ * @brief concurrent hash table
+ *
+ *****************************************************************************/
+
+#include <pthread.h>
+#include <string.h>
+#include "futils/chash.h"
+#include "futils/hash.h"
+
+/* number of lock stripes, must be a power of 2 */
+#define CHASH_STRIPES_SHIFT 6
+#define CHASH_STRIPES (1 << CHASH_STRIPES_SHIFT)
+
+/* stripes are aligned on cache lines to avoid false sharing of locks */
+#define CHASH_CACHE_LINE 64
+
+/* maximum load factor of stripes tables, in percent */
+#define CHASH_MAX_LOAD 100
+
+struct chash_stripe {
+	pthread_rwlock_t lock;
+	struct hash hash;
+} __attribute__((aligned(CHASH_CACHE_LINE)));
+
+struct futils_chash {
+	struct chash_stripe stripes[CHASH_STRIPES];
+};
+
+static struct chash_stripe *chash_stripe(struct futils_chash *hash,
+					 uint32_t key)
+{
+	/* use high bits, stripe hash tables use the key modulo their size */
+	return &hash->stripes[futils_hash_u32(key) >>
+			      (32 - CHASH_STRIPES_SHIFT)];
+}
+
+struct futils_chash *futils_chash_new(size_t size, void (*hfree)(void *))
+{
+	struct futils_chash *hash;
+	size_t i;
+	int ret;
+
+	ret = posix_memalign((void **)&hash, CHASH_CACHE_LINE, sizeof(*hash));
+	if (ret != 0)
+		return NULL;
+	memset(hash, 0, sizeof(*hash));
+
+	for (i = 0; i < CHASH_STRIPES; i++) {
+		ret = futils_hash_init(&hash->stripes[i].hash,
+				       size / CHASH_STRIPES, hfree);
+		if (ret < 0)
+			goto error;
+		futils_hash_set_auto_resize(&hash->stripes[i].hash,
+					    CHASH_MAX_LOAD);
+		ret = pthread_rwlock_init(&hash->stripes[i].lock, NULL);
+		if (ret != 0) {
+			futils_hash_destroy(&hash->stripes[i].hash);
+			goto error;
+		}
+	}
+
+	return hash;
+
+error:
+	while (i-- > 0) {
+		futils_hash_destroy(&hash->stripes[i].hash);
+		pthread_rwlock_destroy(&hash->stripes[i].lock);
+	}
+	free(hash);
+	return NULL;
+}
+
+void futils_chash_destroy(struct futils_chash *hash)
+{
+	size_t i;
+
+	if (!hash)
+		return;
+
+	for (i = 0; i < CHASH_STRIPES; i++) {
+		futils_hash_destroy(&hash->stripes[i].hash);
+		pthread_rwlock_destroy(&hash->stripes[i].lock);
+	}
+	free(hash);
+}
+
+int futils_chash_insert(struct futils_chash *hash, uint32_t key, void *data)
+{
+	struct chash_stripe *stripe;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	stripe = chash_stripe(hash, key);
+	pthread_rwlock_wrlock(&stripe->lock);
+	ret = futils_hash_insert(&stripe->hash, key, data);
+	pthread_rwlock_unlock(&stripe->lock);
+	return ret;
+}
+
+int futils_chash_insert_const(struct futils_chash *hash, uint32_t key,
+			      const void *data)
+{
+	struct chash_stripe *stripe;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	stripe = chash_stripe(hash, key);
+	pthread_rwlock_wrlock(&stripe->lock);
+	ret = futils_hash_insert_const(&stripe->hash, key, data);
+	pthread_rwlock_unlock(&stripe->lock);
+	return ret;
+}
+
+int futils_chash_remove(struct futils_chash *hash, uint32_t key)
+{
+	struct chash_stripe *stripe;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	stripe = chash_stripe(hash, key);
+	pthread_rwlock_wrlock(&stripe->lock);
+	ret = futils_hash_remove(&stripe->hash, key);
+	pthread_rwlock_unlock(&stripe->lock);
+	return ret;
+}
+
+int futils_chash_remove_all(struct futils_chash *hash)
+{
+	struct chash_stripe *stripe;
+	size_t i;
+
+	if (!hash)
+		return -EINVAL;
+
+	for (i = 0; i < CHASH_STRIPES; i++) {
+		stripe = &hash->stripes[i];
+		pthread_rwlock_wrlock(&stripe->lock);
+		futils_hash_remove_all(&stripe->hash);
+		pthread_rwlock_unlock(&stripe->lock);
+	}
+	return 0;
+}
+
+int futils_chash_lookup(struct futils_chash *hash, uint32_t key, void **data)
+{
+	struct chash_stripe *stripe;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	stripe = chash_stripe(hash, key);
+	pthread_rwlock_rdlock(&stripe->lock);
+	ret = futils_hash_lookup(&stripe->hash, key, data);
+	pthread_rwlock_unlock(&stripe->lock);
+	return ret;
+}
+
+int futils_chash_lookup_const(struct futils_chash *hash, uint32_t key,
+			      const void **data)
+{
+	struct chash_stripe *stripe;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	stripe = chash_stripe(hash, key);
+	pthread_rwlock_rdlock(&stripe->lock);
+	ret = futils_hash_lookup_const(&stripe->hash, key, data);
+	pthread_rwlock_unlock(&stripe->lock);
+	return ret;
+}
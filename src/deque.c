@@ -0,0 +1,275 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file deque.c
+ *
+ * @brief chunked double ended queue
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/list.h"
+#include "futils/deque.h"
+
+/* default block size in bytes, when not given */
+#define DEQUE_DEFAULT_BLOCK_BYTES 4096
+
+struct deque_block {
+	struct list_node node;		/* node in deque blocks */
+	uint8_t data[];			/* elements */
+};
+
+struct futils_deque {
+	struct list_node blocks;	/* blocks, front to back */
+	struct deque_block *spare;	/* empty block kept for reuse */
+	size_t elem_size;		/* element size */
+	size_t block_size;		/* number of elements per block */
+	size_t head;			/* front element index in first block */
+	size_t tail;			/* index after back element in last block */
+	size_t count;			/* number of elements */
+};
+
+static inline struct deque_block *deque_first(const struct futils_deque *d)
+{
+	return list_entry(list_first(&d->blocks), struct deque_block, node);
+}
+
+static inline struct deque_block *deque_last(const struct futils_deque *d)
+{
+	return list_entry(list_last(&d->blocks), struct deque_block, node);
+}
+
+static inline uint8_t *deque_elem(const struct futils_deque *d,
+				  struct deque_block *block, size_t idx)
+{
+	return block->data + idx * d->elem_size;
+}
+
+static struct deque_block *deque_block_get(struct futils_deque *d)
+{
+	struct deque_block *block = d->spare;
+
+	if (block) {
+		d->spare = NULL;
+		return block;
+	}
+
+	return malloc(sizeof(*block) + d->block_size * d->elem_size);
+}
+
+static void deque_block_put(struct futils_deque *d, struct deque_block *block)
+{
+	list_del(&block->node);
+	if (!d->spare)
+		d->spare = block;
+	else
+		free(block);
+
+	if (list_is_empty(&d->blocks)) {
+		d->head = 0;
+		d->tail = 0;
+	}
+}
+
+static inline void deque_copy(const struct futils_deque *d, void *dst,
+			      const void *src)
+{
+	if (src)
+		memcpy(dst, src, d->elem_size);
+	else
+		memset(dst, 0, d->elem_size);
+}
+
+struct futils_deque *futils_deque_new(size_t elem_size, size_t block_size)
+{
+	struct futils_deque *d;
+
+	if (elem_size == 0)
+		return NULL;
+
+	if (block_size == 0) {
+		block_size = DEQUE_DEFAULT_BLOCK_BYTES / elem_size;
+		if (block_size < 16)
+			block_size = 16;
+	}
+
+	if (block_size > (SIZE_MAX - sizeof(struct deque_block)) / elem_size)
+		return NULL;
+
+	d = calloc(1, sizeof(*d));
+	if (!d)
+		return NULL;
+
+	list_init(&d->blocks);
+	d->elem_size = elem_size;
+	d->block_size = block_size;
+	return d;
+}
+
+int futils_deque_clear(struct futils_deque *d)
+{
+	struct deque_block *block, *tmp;
+
+	if (!d)
+		return -EINVAL;
+
+	list_walk_entry_forward_safe(&d->blocks, block, tmp, node) {
+		list_del(&block->node);
+		free(block);
+	}
+
+	free(d->spare);
+	d->spare = NULL;
+	d->head = 0;
+	d->tail = 0;
+	d->count = 0;
+	return 0;
+}
+
+void futils_deque_destroy(struct futils_deque *d)
+{
+	if (!d)
+		return;
+
+	futils_deque_clear(d);
+	free(d);
+}
+
+int futils_deque_push_back(struct futils_deque *d, const void *elem)
+{
+	struct deque_block *block;
+
+	if (!d)
+		return -EINVAL;
+
+	if (list_is_empty(&d->blocks) || d->tail == d->block_size) {
+		block = deque_block_get(d);
+		if (!block)
+			return -ENOMEM;
+		if (list_is_empty(&d->blocks))
+			d->head = 0;
+		list_add_before(&d->blocks, &block->node);
+		d->tail = 0;
+	}
+
+	deque_copy(d, deque_elem(d, deque_last(d), d->tail), elem);
+	d->tail++;
+	d->count++;
+	return 0;
+}
+
+int futils_deque_push_front(struct futils_deque *d, const void *elem)
+{
+	struct deque_block *block;
+
+	if (!d)
+		return -EINVAL;
+
+	if (list_is_empty(&d->blocks) || d->head == 0) {
+		block = deque_block_get(d);
+		if (!block)
+			return -ENOMEM;
+		if (list_is_empty(&d->blocks))
+			d->tail = d->block_size;
+		list_add_after(&d->blocks, &block->node);
+		d->head = d->block_size;
+	}
+
+	d->head--;
+	deque_copy(d, deque_elem(d, deque_first(d), d->head), elem);
+	d->count++;
+	return 0;
+}
+
+int futils_deque_pop_back(struct futils_deque *d, void *elem)
+{
+	struct deque_block *block;
+
+	if (!d)
+		return -EINVAL;
+
+	if (d->count == 0)
+		return -ENOENT;
+
+	block = deque_last(d);
+	d->tail--;
+	d->count--;
+	if (elem)
+		memcpy(elem, deque_elem(d, block, d->tail), d->elem_size);
+
+	if (d->tail == 0 || d->count == 0) {
+		deque_block_put(d, block);
+		if (d->count > 0)
+			d->tail = d->block_size;
+	}
+
+	return 0;
+}
+
+int futils_deque_pop_front(struct futils_deque *d, void *elem)
+{
+	struct deque_block *block;
+
+	if (!d)
+		return -EINVAL;
+
+	if (d->count == 0)
+		return -ENOENT;
+
+	block = deque_first(d);
+	if (elem)
+		memcpy(elem, deque_elem(d, block, d->head), d->elem_size);
+	d->head++;
+	d->count--;
+
+	if (d->head == d->block_size || d->count == 0) {
+		deque_block_put(d, block);
+		if (d->count > 0)
+			d->head = 0;
+	}
+
+	return 0;
+}
+
+void *futils_deque_front(const struct futils_deque *d)
+{
+	if (!d || d->count == 0)
+		return NULL;
+
+	return deque_elem(d, deque_first(d), d->head);
+}
+
+void *futils_deque_back(const struct futils_deque *d)
+{
+	if (!d || d->count == 0)
+		return NULL;
+
+	return deque_elem(d, deque_last(d), d->tail - 1);
+}
+
+size_t futils_deque_count(const struct futils_deque *d)
+{
+	return d ? d->count : 0;
+}
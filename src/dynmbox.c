@@ -71,6 +71,9 @@ struct dynmbox {
 	size_t max_msg_size;
 	/* Memory allocated for buffers */
 	uint8_t *bufmem;
+	/* Buffer for messages wrapping around the ring end in
+	 * dynmbox_peek_all(), allocated on first use */
+	uint8_t *scratch;
 	size_t write_idx;
 	size_t read_idx;
 	size_t used;
@@ -345,6 +348,7 @@ void dynmbox_destroy(struct dynmbox *box)
 	}
 	pthread_mutex_destroy(&box->lock);
 	destroy_notify_channel(box);
+	free(box->scratch);
 	free(box->bufmem);
 	free(box);
 }
@@ -498,6 +502,7 @@ int dynmbox_push(struct dynmbox *box,
 			 size_t msg_size)
 {
 	int res;
+	bool was_empty;
 
 	if (!box || msg_size > box->max_msg_size || (msg_size > 0 && !msg))
 		return -EINVAL;
@@ -506,14 +511,18 @@ int dynmbox_push(struct dynmbox *box,
 	pthread_mutex_lock(&box->lock);
 
 	/* Write message to ring buffer */
+	was_empty = rbuf_is_empty(box);
 	res = do_push(box, msg, msg_size);
 	if (res)
 		goto fail;
 
-	pthread_mutex_unlock(&box->lock);
+	/* Write one byte into pipe/socket to signal mbox is readable, only
+	 * for the first queued message: the read fd stays readable until the
+	 * mbox is emptied */
+	if (was_empty)
+		push_notify(box);
 
-	/* Write one byte into pipe/socket to signal mbox is readable */
-	push_notify(box);
+	pthread_mutex_unlock(&box->lock);
 
 	return 0;
 fail:
@@ -542,6 +551,7 @@ int dynmbox_push_block(struct dynmbox *box, const void *msg,
 		size_t msg_size, unsigned int timeout_ms)
 {
 	int res;
+	bool was_empty;
 	struct timeval tv_now;
 	struct timespec ts_now;
 	struct timespec ts_abs;
@@ -573,15 +583,17 @@ int dynmbox_push_block(struct dynmbox *box, const void *msg,
 	}
 
 	/* Write message to ring buffer (should always succeed) */
+	was_empty = rbuf_is_empty(box);
 	res = do_push(box, msg, msg_size);
 	assert(res == 0);
 	if (res)
 		goto fail; /* Return error (NDEBUG case) */
 
-	pthread_mutex_unlock(&box->lock);
-
 	/* Signal consumers */
-	push_notify(box);
+	if (was_empty)
+		push_notify(box);
+
+	pthread_mutex_unlock(&box->lock);
 
 	return 0;
 fail:
@@ -608,14 +620,16 @@ ssize_t dynmbox_peek(struct dynmbox *box, void *msg)
 		goto fail;
 	}
 
-	/* Read one byte from pipe/socket, ignoring failure */
-	pop_notify(box);
-
 	/* Read message from ring buffer */
 	msglen = do_peek(box, msg);
 	if (msglen < 0)
 		goto fail;
 
+	/* Read the notification byte from pipe/socket once the mbox is empty,
+	 * ignoring failure */
+	if (rbuf_is_empty(box))
+		pop_notify(box);
+
 	/* Signal condition */
 	pthread_cond_signal(&box->cond);
 
@@ -628,3 +642,61 @@ fail:
 	pthread_mutex_unlock(&box->lock);
 	return msglen;
 }
+
+int dynmbox_peek_all(struct dynmbox *box, dynmbox_peek_cb_t cb,
+		     void *userdata)
+{
+	int res;
+	int count = 0;
+	uint32_t hdr;
+
+	if (!box || !cb)
+		return -EINVAL;
+
+	/* Lock */
+	res = pthread_mutex_lock(&box->lock);
+	if (res)
+		return -res;
+
+	if (rbuf_is_empty(box)) {
+		res = -EAGAIN;
+		goto out;
+	}
+
+	if (!box->scratch && box->max_msg_size > 0) {
+		box->scratch = malloc(box->max_msg_size);
+		if (!box->scratch) {
+			res = -ENOMEM;
+			goto out;
+		}
+	}
+
+	while (!rbuf_is_empty(box)) {
+		rbuf_read(box, &hdr, sizeof(hdr));
+		assert(hdr <= box->max_msg_size);
+		assert(rbuf_space_used(box) >= hdr);
+
+		if (hdr <= ALLOCATED_LEN - box->read_idx) {
+			/* Contiguous message, give it in place */
+			cb(&box->bufmem[box->read_idx], hdr, userdata);
+			increment(&box->read_idx, hdr);
+			box->used -= hdr;
+		} else {
+			/* Message wraps around ring end */
+			rbuf_read(box, box->scratch, hdr);
+			cb(box->scratch, hdr, userdata);
+		}
+		count++;
+	}
+
+	/* Read the notification byte from pipe/socket, ignoring failure */
+	pop_notify(box);
+
+	/* Wake up all blocked producers */
+	pthread_cond_broadcast(&box->cond);
+
+	res = count;
+out:
+	pthread_mutex_unlock(&box->lock);
+	return res;
+}
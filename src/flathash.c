@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file flathash.c
+ *
+ * @brief open addressing hash table with inline entries
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/flathash.h"
+#include "rh_table.h"
+
+/* minimum table size, must be a power of 2 */
+#define FLATHASH_MIN_SIZE 8
+
+/* maximum table size, must be a power of 2 */
+#define FLATHASH_MAX_SIZE (UINT32_C(1) << 31)
+
+/* maximum load factor, expressed in eighths */
+#define FLATHASH_MAX_LOAD 7
+
+static uint32_t flathash_grow_at(uint32_t size)
+{
+	return (uint32_t)(((uint64_t)size * FLATHASH_MAX_LOAD) / 8);
+}
+
+static int flathash_alloc(struct futils_flathash *hash, size_t size)
+{
+	struct futils_flathash_slot *slots;
+
+	slots = calloc(size, sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+
+	hash->slots = slots;
+	hash->mask = (uint32_t)(size - 1);
+	hash->grow_at = flathash_grow_at((uint32_t)size);
+	return 0;
+}
+
+static uint32_t flathash_get_dib(const void *slot)
+{
+	return ((const struct futils_flathash_slot *)slot)->dib;
+}
+
+static void flathash_set_dib(void *slot, uint32_t dib)
+{
+	((struct futils_flathash_slot *)slot)->dib = dib;
+}
+
+static uint32_t flathash_get_hash(const void *slot)
+{
+	return futils_hash_u32(((const struct futils_flathash_slot *)slot)->key);
+}
+
+static int flathash_match(const void *slot, const void *key)
+{
+	return ((const struct futils_flathash_slot *)slot)->key ==
+	       *(const uint32_t *)key;
+}
+
+static const struct rh_table_ops flathash_ops = {
+	.slot_size = sizeof(struct futils_flathash_slot),
+	.get_dib = &flathash_get_dib,
+	.set_dib = &flathash_set_dib,
+	.get_hash = &flathash_get_hash,
+	.match = &flathash_match,
+};
+
+static void flathash_place(struct futils_flathash *hash,
+			   const struct futils_flathash_slot *slot)
+{
+	rh_table_place(&flathash_ops, hash->slots, hash->mask, slot);
+	hash->count++;
+}
+
+static int flathash_grow(struct futils_flathash *hash)
+{
+	struct futils_flathash_slot *old = hash->slots;
+	size_t old_size = (size_t)hash->mask + 1;
+	int ret;
+
+	if (old_size >= FLATHASH_MAX_SIZE)
+		return -ENOMEM;
+
+	ret = flathash_alloc(hash, old_size * 2);
+	if (ret < 0)
+		return ret;
+
+	/* re-insert all entries in the new table */
+	rh_table_rehash(&flathash_ops, hash->slots, hash->mask, old, old_size);
+
+	free(old);
+	return 0;
+}
+
+static int flathash_find(const struct futils_flathash *hash, uint32_t key,
+			 uint32_t *_idx)
+{
+	return rh_table_find(&flathash_ops, hash->slots, hash->mask,
+			     futils_hash_u32(key), &key, _idx);
+}
+
+int futils_flathash_init(struct futils_flathash *hash, size_t size,
+			 void (*hfree)(void *))
+{
+	size_t tab_size;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	/* reset hash memory */
+	memset(hash, 0, sizeof(*hash));
+
+	/* get upper power of 2 keeping the load factor under its maximum */
+	if (size > FLATHASH_MAX_SIZE / 8 * FLATHASH_MAX_LOAD)
+		return -EINVAL;
+	tab_size = FLATHASH_MIN_SIZE;
+	while (flathash_grow_at(tab_size) < size)
+		tab_size *= 2;
+
+	ret = flathash_alloc(hash, tab_size);
+	if (ret < 0)
+		return ret;
+
+	/* set allocator free callback */
+	hash->hfree = hfree;
+	return 0;
+}
+
+int futils_flathash_remove_all(struct futils_flathash *hash)
+{
+	size_t i;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	for (i = 0; i <= hash->mask; i++) {
+		if (hash->slots[i].dib == 0)
+			continue;
+		if (hash->hfree && !hash->slots[i].is_const)
+			hash->hfree(hash->slots[i].data);
+	}
+
+	memset(hash->slots, 0, ((size_t)hash->mask + 1) * sizeof(*hash->slots));
+	hash->count = 0;
+	return 0;
+}
+
+int futils_flathash_destroy(struct futils_flathash *hash)
+{
+	if (!hash)
+		return -EINVAL;
+
+	if (hash->slots)
+		futils_flathash_remove_all(hash);
+	free(hash->slots);
+	memset(hash, 0, sizeof(*hash));
+	return 0;
+}
+
+static int futils_flathash_insert_slot(struct futils_flathash *hash,
+				       struct futils_flathash_slot slot)
+{
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	/* compare keys to find if another entry with same key has been
+	 * already added */
+	if (flathash_find(hash, slot.key, &idx) == 0)
+		return -EEXIST;
+
+	if (hash->count >= hash->grow_at) {
+		ret = flathash_grow(hash);
+		if (ret < 0)
+			return ret;
+	}
+
+	flathash_place(hash, &slot);
+	return 0;
+}
+
+int futils_flathash_insert(struct futils_flathash *hash, uint32_t key,
+			   void *data)
+{
+	struct futils_flathash_slot slot;
+
+	memset(&slot, 0, sizeof(slot));
+	slot.key = key;
+	slot.is_const = 0;
+	slot.data = data;
+
+	return futils_flathash_insert_slot(hash, slot);
+}
+
+int futils_flathash_insert_const(struct futils_flathash *hash, uint32_t key,
+				 const void *data)
+{
+	struct futils_flathash_slot slot;
+
+	memset(&slot, 0, sizeof(slot));
+	slot.key = key;
+	slot.is_const = 1;
+	slot.const_data = data;
+
+	return futils_flathash_insert_slot(hash, slot);
+}
+
+int futils_flathash_lookup(const struct futils_flathash *hash, uint32_t key,
+			   void **data)
+{
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	ret = flathash_find(hash, key, &idx);
+	if (ret < 0)
+		return ret;
+
+	if (hash->slots[idx].is_const)
+		return -EPERM;
+
+	if (data)
+		*data = hash->slots[idx].data;
+
+	return 0;
+}
+
+int futils_flathash_lookup_const(const struct futils_flathash *hash,
+				 uint32_t key, const void **data)
+{
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	ret = flathash_find(hash, key, &idx);
+	if (ret < 0)
+		return ret;
+
+	if (data)
+		*data = hash->slots[idx].const_data;
+
+	return 0;
+}
+
+int futils_flathash_remove(struct futils_flathash *hash, uint32_t key)
+{
+	struct futils_flathash_slot *slot;
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	ret = flathash_find(hash, key, &idx);
+	if (ret < 0)
+		return ret;
+
+	slot = &hash->slots[idx];
+	if (hash->hfree && !slot->is_const)
+		hash->hfree(slot->data);
+
+	rh_table_remove_at(&flathash_ops, hash->slots, hash->mask, idx);
+	hash->count--;
+	return 0;
+}
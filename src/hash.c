@@ -29,6 +29,7 @@
  *
  *****************************************************************************/
 
+#include <limits.h>
 #include <string.h>
 #include "futils/hash.h"
 
@@ -47,6 +48,18 @@ static const uint32_t futils_hash_prime_tab_length =
 			sizeof(futils_hash_prime_tab) /
 			sizeof(futils_hash_prime_tab[0]);
 
+/* number of buckets migrated by each insert or remove while growing */
+#define HASH_MIGRATE_STEP 8
+
+/* number of keys resolved together by batched lookups */
+#define HASH_LOOKUP_BATCH 16
+
+#ifdef __GNUC__
+#define hash_prefetch(_addr) __builtin_prefetch(_addr)
+#else
+#define hash_prefetch(_addr) ((void)(_addr))
+#endif
+
 #define DJB2_HASH_START (5381)
 #define MULT33(_x_) (((_x_) << 5)+(_x_))
 
@@ -70,6 +83,118 @@ static uint32_t hash_32(uint32_t key)
 	return hash;
 }
 
+/**
+ * wyhash secret
+ */
+static const uint64_t wyhash_secret[4] = {
+	0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+	0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+};
+
+/* 64x64 -> 128bit multiplication, low part in a, high part in b */
+static inline void wyhash_mum(uint64_t *a, uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)*a * *b;
+
+	*a = (uint64_t)r;
+	*b = (uint64_t)(r >> 64);
+#else
+	uint64_t ha = *a >> 32, hb = *b >> 32;
+	uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+	uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	uint64_t t = rl + (rm0 << 32), lo, hi;
+	uint64_t c = t < rl;
+
+	lo = t + (rm1 << 32);
+	c += lo < t;
+	hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+	*a = lo;
+	*b = hi;
+#endif
+}
+
+static inline uint64_t wyhash_mix(uint64_t a, uint64_t b)
+{
+	wyhash_mum(&a, &b);
+	return a ^ b;
+}
+
+static inline uint64_t wyhash_r8(const uint8_t *p)
+{
+	uint64_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint64_t wyhash_r4(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint64_t wyhash_r3(const uint8_t *p, size_t k)
+{
+	return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t futils_hash_bytes(const void *data, size_t len, uint64_t seed)
+{
+	const uint64_t *s = wyhash_secret;
+	const uint8_t *p = data;
+	uint64_t a, b, see1, see2;
+	size_t i;
+
+	seed ^= wyhash_mix(seed ^ s[0], s[1]);
+
+	if (len <= 16) {
+		if (len >= 4) {
+			a = (wyhash_r4(p) << 32) | wyhash_r4(p + ((len >> 3) << 2));
+			b = (wyhash_r4(p + len - 4) << 32) |
+			    wyhash_r4(p + len - 4 - ((len >> 3) << 2));
+		} else if (len > 0) {
+			a = wyhash_r3(p, len);
+			b = 0;
+		} else {
+			a = 0;
+			b = 0;
+		}
+	} else {
+		i = len;
+		if (i >= 48) {
+			see1 = seed;
+			see2 = seed;
+			do {
+				seed = wyhash_mix(wyhash_r8(p) ^ s[1],
+						  wyhash_r8(p + 8) ^ seed);
+				see1 = wyhash_mix(wyhash_r8(p + 16) ^ s[2],
+						  wyhash_r8(p + 24) ^ see1);
+				see2 = wyhash_mix(wyhash_r8(p + 32) ^ s[3],
+						  wyhash_r8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i >= 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = wyhash_mix(wyhash_r8(p) ^ s[1],
+					  wyhash_r8(p + 8) ^ seed);
+			i -= 16;
+			p += 16;
+		}
+		a = wyhash_r8(p + i - 16);
+		b = wyhash_r8(p + i - 8);
+	}
+
+	a ^= s[1];
+	b ^= seed;
+	wyhash_mum(&a, &b);
+	return wyhash_mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
 int futils_hash_init(struct hash *hash, size_t size, void (*hfree)(void *))
 {
 	size_t i;
@@ -107,26 +232,150 @@ error:
 	return ret;
 }
 
-int futils_hash_remove_all(struct hash *hash)
+int futils_hash_set_auto_resize(struct hash *hash, uint32_t max_load)
 {
-	size_t i;
-	struct hash_entry *entry, *next;
-
 	if (!hash)
 		return -EINVAL;
 
-	for (i = 0; i < hash->size; i++) {
-		entry = hash->buckets[i];
+	hash->max_load = max_load;
+	return 0;
+}
+
+/**
+ * Find the reference to an entry from its key: either the bucket head or the
+ * next pointer of the previous entry in chain. The referenced pointer is NULL
+ * if there is no entry with this key. The number of entries compared is added
+ * to probes.
+ */
+static struct hash_entry **hash_find_ref(struct hash_entry **buckets,
+					 uint32_t size, uint32_t hash_val,
+					 uint32_t key, uint32_t *probes)
+{
+	struct hash_entry **ref = &buckets[hash_val % size];
+
+	while (*ref) {
+		(*probes)++;
+		if ((*ref)->key == key)
+			break;
+		ref = &(*ref)->next;
+	}
+
+	return ref;
+}
+
+static struct hash_entry **hash_find(const struct hash *hash, uint32_t key,
+				     uint32_t *probes)
+{
+	struct hash_entry **ref;
+	uint32_t hash_val = hash_32(key);
+
+	ref = hash_find_ref(hash->buckets, hash->size, hash_val, key, probes);
+	if (*ref || !hash->old_buckets)
+		return ref;
+
+	/* entry may not have been migrated yet */
+	return hash_find_ref(hash->old_buckets, hash->old_size, hash_val, key,
+			     probes);
+}
+
+/* update optional lookup counters */
+static void hash_count_lookup(const struct hash *hash, uint32_t probes)
+{
+	if (!hash->counters)
+		return;
+
+	hash->counters->lookups++;
+	hash->counters->probes += probes;
+}
+
+static void hash_migrate_end(struct hash *hash)
+{
+	free(hash->old_buckets);
+	hash->old_buckets = NULL;
+	hash->old_size = 0;
+	hash->migrate_idx = 0;
+}
+
+/* move entries of at most count old buckets in new buckets */
+static void hash_migrate(struct hash *hash, uint32_t count)
+{
+	struct hash_entry *entry, *next;
+	uint32_t hash_val;
+
+	while (count > 0 && hash->migrate_idx < hash->old_size) {
+		entry = hash->old_buckets[hash->migrate_idx];
+		while (entry) {
+			next = entry->next;
+			hash_val = hash_32(entry->key) % hash->size;
+			entry->next = hash->buckets[hash_val];
+			hash->buckets[hash_val] = entry;
+			entry = next;
+		}
+		hash->old_buckets[hash->migrate_idx] = NULL;
+		hash->migrate_idx++;
+		count--;
+	}
+
+	if (hash->migrate_idx == hash->old_size)
+		hash_migrate_end(hash);
+}
+
+static void hash_grow(struct hash *hash)
+{
+	struct hash_entry **buckets;
+	size_t i;
+
+	for (i = 0; (futils_hash_prime_tab[i] <= hash->size) &&
+		    ((i + 1) < futils_hash_prime_tab_length); i++)
+		;
+	if (futils_hash_prime_tab[i] <= hash->size)
+		return;
+
+	/* keep current size if allocation fails */
+	buckets = calloc(futils_hash_prime_tab[i], sizeof(struct hash_entry *));
+	if (!buckets)
+		return;
+
+	hash->old_buckets = hash->buckets;
+	hash->old_size = hash->size;
+	hash->migrate_idx = 0;
+	hash->buckets = buckets;
+	hash->size = futils_hash_prime_tab[i];
+}
+
+static void hash_free_buckets(struct hash *hash, struct hash_entry **buckets,
+			      uint32_t size)
+{
+	size_t i;
+	struct hash_entry *entry, *next;
+
+	for (i = 0; i < size; i++) {
+		entry = buckets[i];
 		while (entry) {
 			next = entry->next;
 			list_del(&entry->node);
-			if (hash->hfree)
-				hash->hfree(entry->data);
-			free(entry);
+			if (!entry->is_intrusive) {
+				if (hash->hfree)
+					hash->hfree(entry->data);
+				free(entry);
+			}
 			entry = next;
 		}
-		hash->buckets[i] = NULL;
+		buckets[i] = NULL;
 	}
+}
+
+int futils_hash_remove_all(struct hash *hash)
+{
+	if (!hash)
+		return -EINVAL;
+
+	hash_free_buckets(hash, hash->buckets, hash->size);
+	if (hash->old_buckets) {
+		hash_free_buckets(hash, hash->old_buckets, hash->old_size);
+		hash_migrate_end(hash);
+	}
+	hash->count = 0;
 
 	return 0;
 }
@@ -138,6 +387,7 @@ int futils_hash_destroy(struct hash *hash)
 
 	futils_hash_remove_all(hash);
 	free(hash->buckets);
+	free(hash->counters);
 	memset(hash, 0 , sizeof(*hash));
 	return 0;
 }
@@ -146,32 +396,34 @@ static int futils_hash_insert_entry(struct hash *hash, uint32_t key,
 				    struct hash_entry *new_entry)
 {
 	uint32_t hash_val;
-	struct hash_entry *entry;
-
-	/* compute entry hash from key */
-	hash_val = hash_32(key);
-	hash_val = hash_val % hash->size;
-
-	entry = hash->buckets[hash_val];
+	uint32_t probes = 0;
 
 	/**
 	 * compare hash entries key to find if another entry
 	 * with same key has been already added */
-	while (entry) {
-		if (entry->key == key) {
-			/* obus_warn("hash key %d already exist !", key); */
-			return -EEXIST;
-		}
-
-		entry = entry->next;
+	if (*hash_find(hash, key, &probes)) {
+		/* obus_warn("hash key %d already exist !", key); */
+		return -EEXIST;
 	}
 
+	/* start or continue growing table */
+	if (hash->old_buckets)
+		hash_migrate(hash, HASH_MIGRATE_STEP);
+	else if (hash->max_load && hash->count >=
+		 ((uint64_t)hash->size * hash->max_load) / 100)
+		hash_grow(hash);
+
+	/* compute entry hash from key */
+	hash_val = hash_32(key);
+	hash_val = hash_val % hash->size;
+
 	/* insert at list head */
 	new_entry->next = hash->buckets[hash_val];
 	hash->buckets[hash_val] = new_entry;
 
 	/* add entry in list */
 	list_add_before(&hash->entries, &new_entry->node);
+	hash->count++;
 	return 0;
 }
 
@@ -199,6 +451,19 @@ int futils_hash_insert(struct hash *hash, uint32_t key, void *data)
 	return ret;
 }
 
+int futils_hash_link(struct hash *hash, uint32_t key, struct hash_entry *entry)
+{
+	if (!hash || !entry)
+		return -EINVAL;
+
+	entry->is_const = 0;
+	entry->is_intrusive = 1;
+	entry->key = key;
+	entry->next = NULL;
+
+	return futils_hash_insert_entry(hash, key, entry);
+}
+
 int futils_hash_insert_const(struct hash *hash, uint32_t key,
 			     const void *data)
 {
@@ -224,23 +489,18 @@ int futils_hash_insert_const(struct hash *hash, uint32_t key,
 	return ret;
 }
 
-static int futils_hash_lookup_entry(const struct hash *tab, uint32_t key,
-				    struct hash_entry **_entry)
+int futils_hash_lookup_entry(const struct hash *tab, uint32_t key,
+			     struct hash_entry **_entry)
 {
 	struct hash_entry *entry;
-	uint32_t hash;
+	uint32_t probes = 0;
 
 	if (!tab || !_entry)
 		return -EINVAL;
 
-	/* compute entry hash from key and find entry from buckets */
-	hash = hash_32(key);
-	hash = hash % tab->size;
-	entry = tab->buckets[hash];
-
-	/* compare keys to find correct entry */
-	while (entry && entry->key != key)
-		entry = entry->next;
+	/* compute entry hash from key and compare keys to find entry */
+	entry = *hash_find(tab, key, &probes);
+	hash_count_lookup(tab, probes);
 
 	/* entry not found */
 	if (!entry)
@@ -250,6 +510,108 @@ static int futils_hash_lookup_entry(const struct hash *tab, uint32_t key,
 	return 0;
 }
 
+/**
+ * Resolve at most HASH_LOOKUP_BATCH keys: hash all keys and prefetch their
+ * buckets, then load bucket heads and prefetch first entries, and only then
+ * walk the chains.
+ */
+static void hash_lookup_batch(const struct hash *tab, const uint32_t *keys,
+			      size_t n, struct hash_entry **entries)
+{
+	uint32_t hash_val[HASH_LOOKUP_BATCH];
+	struct hash_entry *entry;
+	uint32_t probes;
+	size_t i;
+
+	for (i = 0; i < n; i++) {
+		hash_val[i] = hash_32(keys[i]);
+		hash_prefetch(&tab->buckets[hash_val[i] % tab->size]);
+	}
+
+	for (i = 0; i < n; i++) {
+		entries[i] = tab->buckets[hash_val[i] % tab->size];
+		if (entries[i])
+			hash_prefetch(entries[i]);
+	}
+
+	for (i = 0; i < n; i++) {
+		probes = 0;
+		entry = entries[i];
+		while (entry) {
+			probes++;
+			if (entry->key == keys[i])
+				break;
+			entry = entry->next;
+		}
+
+		/* entry may not have been migrated yet */
+		if (!entry && tab->old_buckets)
+			entry = *hash_find_ref(tab->old_buckets, tab->old_size,
+					       hash_val[i], keys[i], &probes);
+		entries[i] = entry;
+		hash_count_lookup(tab, probes);
+	}
+}
+
+int futils_hash_lookup_batch(const struct hash *hash, const uint32_t *keys,
+			     size_t n, void **out)
+{
+	struct hash_entry *entries[HASH_LOOKUP_BATCH];
+	size_t base, i, count;
+	int found = 0;
+
+	if (!hash || (n > 0 && (!keys || !out)) || n > INT_MAX)
+		return -EINVAL;
+
+	for (base = 0; base < n; base += count) {
+		count = n - base;
+		if (count > HASH_LOOKUP_BATCH)
+			count = HASH_LOOKUP_BATCH;
+
+		hash_lookup_batch(hash, &keys[base], count, entries);
+		for (i = 0; i < count; i++) {
+			if (entries[i] && !entries[i]->is_const) {
+				out[base + i] = entries[i]->data;
+				found++;
+			} else {
+				out[base + i] = NULL;
+			}
+		}
+	}
+
+	return found;
+}
+
+int futils_hash_lookup_batch_const(const struct hash *hash,
+				   const uint32_t *keys, size_t n,
+				   const void **out)
+{
+	struct hash_entry *entries[HASH_LOOKUP_BATCH];
+	size_t base, i, count;
+	int found = 0;
+
+	if (!hash || (n > 0 && (!keys || !out)) || n > INT_MAX)
+		return -EINVAL;
+
+	for (base = 0; base < n; base += count) {
+		count = n - base;
+		if (count > HASH_LOOKUP_BATCH)
+			count = HASH_LOOKUP_BATCH;
+
+		hash_lookup_batch(hash, &keys[base], count, entries);
+		for (i = 0; i < count; i++) {
+			if (entries[i]) {
+				out[base + i] = entries[i]->const_data;
+				found++;
+			} else {
+				out[base + i] = NULL;
+			}
+		}
+	}
+
+	return found;
+}
+
 int futils_hash_lookup(const struct hash *hash, uint32_t key, void **data)
 {
 	struct hash_entry *entry;
@@ -284,40 +646,123 @@ int futils_hash_lookup_const(const struct hash *hash, uint32_t key,
 	return 0;
 }
 
+static void hash_unlink_ref(struct hash *tab, struct hash_entry **ref)
+{
+	struct hash_entry *entry = *ref;
+
+	/* remove entry */
+	*ref = entry->next;
+
+	list_del(&entry->node);
+	if (!entry->is_intrusive) {
+		if (tab->hfree)
+			tab->hfree(entry->data);
+		free(entry);
+	}
+	tab->count--;
+
+	if (tab->old_buckets)
+		hash_migrate(tab, HASH_MIGRATE_STEP);
+}
+
 int futils_hash_remove(struct hash *tab, uint32_t key)
 {
-	struct hash_entry *entry, *prev;
-	uint32_t hash;
+	struct hash_entry **ref;
+	uint32_t probes = 0;
 
 	if (!tab)
 		return -EINVAL;
 
-	/* compute entry hash from key and find entry from buckets */
-	hash = hash_32(key);
-	hash = hash % tab->size;
-	entry = tab->buckets[hash];
-
-	/* compare keys to find correct entry */
-	prev = NULL;
-	while (entry && entry->key != key) {
-		prev = entry;
-		entry = entry->next;
-	}
+	/* compute entry hash from key and compare keys to find entry */
+	ref = hash_find(tab, key, &probes);
 
 	/* entry not found */
-	if (!entry)
+	if (!*ref)
 		return -ENOENT;
 
-	/* remove entry */
-	if (!prev)
-		tab->buckets[hash] = entry->next;
-	else
-		prev->next = entry->next;
+	hash_unlink_ref(tab, ref);
+	return 0;
+}
 
-	list_del(&entry->node);
-	if (tab->hfree)
-		tab->hfree(entry->data);
-	free(entry);
+int futils_hash_unlink(struct hash *tab, struct hash_entry *entry)
+{
+	struct hash_entry **ref;
+	uint32_t probes = 0;
+
+	if (!tab || !entry)
+		return -EINVAL;
+
+	/* entry must be the one linked with its key */
+	ref = hash_find(tab, entry->key, &probes);
+	if (*ref != entry)
+		return -ENOENT;
+
+	hash_unlink_ref(tab, ref);
 	return 0;
 }
 
+int futils_hash_enable_counters(struct hash *hash, int enable)
+{
+	if (!hash)
+		return -EINVAL;
+
+	if (!enable) {
+		free(hash->counters);
+		hash->counters = NULL;
+		return 0;
+	}
+
+	if (!hash->counters) {
+		hash->counters = calloc(1, sizeof(*hash->counters));
+		if (!hash->counters)
+			return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static void hash_stats_buckets(struct hash_entry **buckets, uint32_t size,
+			       struct futils_hash_stats *stats)
+{
+	struct hash_entry *entry;
+	uint32_t i, len;
+
+	for (i = 0; i < size; i++) {
+		len = 0;
+		for (entry = buckets[i]; entry; entry = entry->next)
+			len++;
+
+		if (len > 0)
+			stats->used_buckets++;
+		if (len > stats->max_chain)
+			stats->max_chain = len;
+		if (len >= FUTILS_HASH_STATS_HIST_LEN)
+			len = FUTILS_HASH_STATS_HIST_LEN - 1;
+		stats->chain_hist[len]++;
+	}
+}
+
+int futils_hash_get_stats(const struct hash *hash,
+			  struct futils_hash_stats *stats)
+{
+	if (!hash || !stats)
+		return -EINVAL;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->size = hash->size;
+	stats->count = hash->count;
+	if (hash->size)
+		stats->load_factor = (uint32_t)(((uint64_t)hash->count * 100) /
+						hash->size);
+
+	hash_stats_buckets(hash->buckets, hash->size, stats);
+	if (hash->old_buckets)
+		hash_stats_buckets(hash->old_buckets, hash->old_size, stats);
+
+	if (hash->counters) {
+		stats->lookups = hash->counters->lookups;
+		stats->probes = hash->counters->probes;
+	}
+
+	return 0;
+}
@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file heap.c
+ *
+ * @brief intrusive 4-ary min-heap
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/heap.h"
+
+/* number of children per item */
+#define HEAP_ARITY 4
+
+/* minimum array size */
+#define HEAP_MIN_SIZE 16
+
+static inline int heap_less(const struct futils_heap *heap,
+			    const struct futils_heap_item *a,
+			    const struct futils_heap_item *b)
+{
+	if (heap->cmp)
+		return heap->cmp(a->node, b->node) < 0;
+	return a->key < b->key;
+}
+
+static inline void heap_set(struct futils_heap *heap, uint32_t idx,
+			    struct futils_heap_item item)
+{
+	heap->items[idx] = item;
+	item.node->index = idx;
+}
+
+static void heap_sift_up(struct futils_heap *heap, uint32_t idx)
+{
+	struct futils_heap_item item = heap->items[idx];
+	uint32_t parent;
+
+	while (idx > 0) {
+		parent = (idx - 1) / HEAP_ARITY;
+		if (!heap_less(heap, &item, &heap->items[parent]))
+			break;
+		heap_set(heap, idx, heap->items[parent]);
+		idx = parent;
+	}
+
+	heap_set(heap, idx, item);
+}
+
+static void heap_sift_down(struct futils_heap *heap, uint32_t idx)
+{
+	struct futils_heap_item item = heap->items[idx];
+	uint32_t child, best, end, i;
+
+	for (;;) {
+		child = idx * HEAP_ARITY + 1;
+		if (child >= heap->count)
+			break;
+
+		/* smallest of adjacent children */
+		best = child;
+		end = child + HEAP_ARITY;
+		if (end > heap->count)
+			end = heap->count;
+		for (i = child + 1; i < end; i++) {
+			if (heap_less(heap, &heap->items[i],
+				      &heap->items[best]))
+				best = i;
+		}
+
+		if (!heap_less(heap, &heap->items[best], &item))
+			break;
+		heap_set(heap, idx, heap->items[best]);
+		idx = best;
+	}
+
+	heap_set(heap, idx, item);
+}
+
+static int heap_grow(struct futils_heap *heap)
+{
+	struct futils_heap_item *items;
+	uint32_t size;
+
+	if (heap->size >= UINT32_MAX / 2)
+		return -ENOMEM;
+
+	size = heap->size ? heap->size * 2 : HEAP_MIN_SIZE;
+	items = realloc(heap->items, size * sizeof(*items));
+	if (!items)
+		return -ENOMEM;
+
+	heap->items = items;
+	heap->size = size;
+	return 0;
+}
+
+int futils_heap_init(struct futils_heap *heap, size_t size,
+		     futils_heap_cmp_t cmp)
+{
+	if (!heap || size >= UINT32_MAX / 2)
+		return -EINVAL;
+
+	memset(heap, 0, sizeof(*heap));
+	heap->cmp = cmp;
+	if (size == 0)
+		return 0;
+
+	heap->items = calloc(size, sizeof(*heap->items));
+	if (!heap->items)
+		return -ENOMEM;
+
+	heap->size = (uint32_t)size;
+	return 0;
+}
+
+int futils_heap_destroy(struct futils_heap *heap)
+{
+	if (!heap)
+		return -EINVAL;
+
+	free(heap->items);
+	memset(heap, 0, sizeof(*heap));
+	return 0;
+}
+
+int futils_heap_push(struct futils_heap *heap, struct futils_heap_node *node)
+{
+	int ret;
+
+	if (!heap || !node || futils_heap_node_is_queued(node))
+		return -EINVAL;
+
+	if (heap->count == heap->size) {
+		ret = heap_grow(heap);
+		if (ret < 0)
+			return ret;
+	}
+
+	heap->items[heap->count].key = node->key;
+	heap->items[heap->count].node = node;
+	heap->count++;
+	heap_sift_up(heap, heap->count - 1);
+	return 0;
+}
+
+int futils_heap_remove(struct futils_heap *heap,
+		       struct futils_heap_node *node)
+{
+	uint32_t idx;
+
+	if (!heap || !node || node->index >= heap->count ||
+	    heap->items[node->index].node != node)
+		return -EINVAL;
+
+	idx = node->index;
+	node->index = FUTILS_HEAP_NO_INDEX;
+	heap->count--;
+	if (idx == heap->count)
+		return 0;
+
+	/* move last item in the hole, then restore order */
+	heap->items[idx] = heap->items[heap->count];
+	if (idx > 0 && heap_less(heap, &heap->items[idx],
+				 &heap->items[(idx - 1) / HEAP_ARITY]))
+		heap_sift_up(heap, idx);
+	else
+		heap_sift_down(heap, idx);
+
+	return 0;
+}
+
+struct futils_heap_node *futils_heap_pop(struct futils_heap *heap)
+{
+	struct futils_heap_node *node;
+
+	if (!heap || heap->count == 0)
+		return NULL;
+
+	node = heap->items[0].node;
+	futils_heap_remove(heap, node);
+	return node;
+}
+
+int futils_heap_update(struct futils_heap *heap,
+		       struct futils_heap_node *node)
+{
+	uint32_t idx;
+
+	if (!heap || !node || node->index >= heap->count ||
+	    heap->items[node->index].node != node)
+		return -EINVAL;
+
+	idx = node->index;
+	heap->items[idx].key = node->key;
+	if (idx > 0 && heap_less(heap, &heap->items[idx],
+				 &heap->items[(idx - 1) / HEAP_ARITY]))
+		heap_sift_up(heap, idx);
+	else
+		heap_sift_down(heap, idx);
+
+	return 0;
+}
@@ -0,0 +1,259 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file lru.c
+ *
+ * @brief bounded least recently used cache
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "futils/hash.h"
+#include "futils/lru.h"
+
+/* maximum load factor of the index, in percent */
+#define LRU_MAX_LOAD 100
+
+/* initial size of the index, grown as entries are added */
+#define LRU_MIN_SIZE 16
+
+struct lru_entry {
+	/* index entry, key is stored here */
+	struct hash_entry hentry;
+	/* node in recency list */
+	struct list_node node;
+	/* cached value */
+	void *value;
+	/* value size */
+	size_t size;
+};
+
+struct futils_lru {
+	/* entries index */
+	struct hash index;
+	/* entries, most recently used first */
+	struct list_node entries;
+	/* limits, 0 if none */
+	size_t max_entries;
+	size_t max_bytes;
+	/* release callback */
+	void (*release)(uint32_t key, void *value, void *userdata);
+	void *userdata;
+	/* counters */
+	struct futils_lru_stats stats;
+};
+
+static void lru_release(struct futils_lru *lru, uint32_t key, void *value)
+{
+	if (lru->release)
+		lru->release(key, value, lru->userdata);
+}
+
+static void lru_entry_remove(struct futils_lru *lru, struct lru_entry *entry)
+{
+	uint32_t key = entry->hentry.key;
+	void *value = entry->value;
+
+	futils_hash_unlink(&lru->index, &entry->hentry);
+	list_del(&entry->node);
+	lru->stats.entries--;
+	lru->stats.bytes -= entry->size;
+	free(entry);
+
+	/* release once the entry is no longer reachable */
+	lru_release(lru, key, value);
+}
+
+static int lru_is_full(const struct futils_lru *lru)
+{
+	return (lru->max_entries && lru->stats.entries > lru->max_entries) ||
+	       (lru->max_bytes && lru->stats.bytes > lru->max_bytes);
+}
+
+/* evict least recently used entries, keeping the most recent one */
+static void lru_evict(struct futils_lru *lru)
+{
+	struct lru_entry *entry;
+
+	while (lru_is_full(lru) && lru->stats.entries > 1) {
+		entry = list_entry(list_last(&lru->entries),
+				   struct lru_entry, node);
+		lru->stats.evictions++;
+		lru_entry_remove(lru, entry);
+	}
+}
+
+static struct lru_entry *lru_find(const struct futils_lru *lru, uint32_t key)
+{
+	struct hash_entry *hentry;
+
+	if (futils_hash_lookup_entry(&lru->index, key, &hentry) < 0)
+		return NULL;
+
+	return futils_hash_entry(hentry, struct lru_entry, hentry);
+}
+
+struct futils_lru *futils_lru_new(size_t max_entries, size_t max_bytes,
+		void (*release)(uint32_t key, void *value, void *userdata),
+		void *userdata)
+{
+	struct futils_lru *lru;
+	int ret;
+
+	lru = calloc(1, sizeof(*lru));
+	if (!lru)
+		return NULL;
+
+	ret = futils_hash_init(&lru->index, LRU_MIN_SIZE, NULL);
+	if (ret < 0) {
+		free(lru);
+		return NULL;
+	}
+	futils_hash_set_auto_resize(&lru->index, LRU_MAX_LOAD);
+
+	list_init(&lru->entries);
+	lru->max_entries = max_entries;
+	lru->max_bytes = max_bytes;
+	lru->release = release;
+	lru->userdata = userdata;
+	return lru;
+}
+
+int futils_lru_clear(struct futils_lru *lru)
+{
+	struct lru_entry *entry;
+
+	if (!lru)
+		return -EINVAL;
+
+	while (!list_is_empty(&lru->entries)) {
+		entry = list_entry(list_first(&lru->entries),
+				   struct lru_entry, node);
+		lru_entry_remove(lru, entry);
+	}
+
+	return 0;
+}
+
+void futils_lru_destroy(struct futils_lru *lru)
+{
+	if (!lru)
+		return;
+
+	futils_lru_clear(lru);
+	futils_hash_destroy(&lru->index);
+	free(lru);
+}
+
+int futils_lru_put(struct futils_lru *lru, uint32_t key, void *value,
+		   size_t size)
+{
+	struct lru_entry *entry;
+	void *old;
+	int ret;
+
+	if (!lru)
+		return -EINVAL;
+
+	if (lru->max_bytes && size > lru->max_bytes)
+		return -E2BIG;
+
+	entry = lru_find(lru, key);
+	if (entry) {
+		/* replace value in place */
+		old = entry->value;
+		lru->stats.bytes = lru->stats.bytes - entry->size + size;
+		entry->value = value;
+		entry->size = size;
+		list_move_after(&lru->entries, &entry->node);
+		if (old != value)
+			lru_release(lru, key, old);
+	} else {
+		entry = calloc(1, sizeof(*entry));
+		if (!entry)
+			return -ENOMEM;
+
+		ret = futils_hash_link(&lru->index, key, &entry->hentry);
+		if (ret < 0) {
+			free(entry);
+			return ret;
+		}
+		entry->value = value;
+		entry->size = size;
+		list_add_after(&lru->entries, &entry->node);
+		lru->stats.entries++;
+		lru->stats.bytes += size;
+	}
+
+	lru_evict(lru);
+	return 0;
+}
+
+int futils_lru_get(struct futils_lru *lru, uint32_t key, void **value)
+{
+	struct lru_entry *entry;
+
+	if (!lru)
+		return -EINVAL;
+
+	entry = lru_find(lru, key);
+	if (!entry) {
+		lru->stats.misses++;
+		return -ENOENT;
+	}
+
+	lru->stats.hits++;
+	list_move_after(&lru->entries, &entry->node);
+	if (value)
+		*value = entry->value;
+
+	return 0;
+}
+
+int futils_lru_erase(struct futils_lru *lru, uint32_t key)
+{
+	struct lru_entry *entry;
+
+	if (!lru)
+		return -EINVAL;
+
+	entry = lru_find(lru, key);
+	if (!entry)
+		return -ENOENT;
+
+	lru_entry_remove(lru, entry);
+	return 0;
+}
+
+int futils_lru_get_stats(const struct futils_lru *lru,
+			 struct futils_lru_stats *stats)
+{
+	if (!lru || !stats)
+		return -EINVAL;
+
+	*stats = lru->stats;
+	return 0;
+}
@@ -36,6 +36,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
+#include <stdint.h>
 #include "futils/fdutils.h"
 #include "futils/mbox.h"
 
@@ -45,14 +46,195 @@ ULOG_DECLARE_TAG(mbox);
 
 #ifndef _WIN32
 #include <poll.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "futils/timetools.h"
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+/* userspace ring of fixed size messages */
+struct mbox_ring {
+	uint8_t *buf;			/* messages */
+	size_t capacity;		/* max number of messages */
+	size_t head;			/* index of first queued message */
+	size_t count;			/* number of queued messages */
+	pthread_mutex_t lock;
+	pthread_cond_t cond;		/* signaled when ring is no more full */
+};
 
 struct mbox {
-	/* pipes fds */
+	/* pipes fds, or eventfd in both entries for ring mail boxes */
 	int fds[2];
 	/* message size */
 	size_t msg_size;
+	/* userspace ring, NULL if messages go through the pipe */
+	struct mbox_ring *ring;
 };
 
+/* make read fd readable, called with ring lock held when the ring becomes
+ * non empty */
+static void ring_notify(struct mbox *box)
+{
+	ssize_t ret;
+#ifdef __linux__
+	const uint64_t val = 1;
+#else
+	const uint8_t val = 0x55;
+#endif
+
+	do {
+		ret = write(box->fds[1], &val, sizeof(val));
+	} while (ret == -1 && errno == EINTR);
+	if (ret == -1)
+		ULOG_ERRNO("write() notify", errno);
+}
+
+/* make read fd non readable, called with ring lock held when the ring
+ * becomes empty */
+static void ring_drain(struct mbox *box)
+{
+	ssize_t ret;
+#ifdef __linux__
+	uint64_t val;
+#else
+	uint8_t val;
+#endif
+
+	do {
+		ret = read(box->fds[0], &val, sizeof(val));
+	} while (ret == -1 && errno == EINTR);
+	if (ret == -1)
+		ULOG_ERRNO("read() notify", errno);
+}
+
+/* copy n messages in ring, caller must check there is enough room */
+static void ring_write(struct mbox *box, const uint8_t *msgs, size_t n)
+{
+	struct mbox_ring *ring = box->ring;
+	size_t idx = (ring->head + ring->count) % ring->capacity;
+	size_t chunk = ring->capacity - idx;
+
+	if (chunk > n)
+		chunk = n;
+	memcpy(ring->buf + idx * box->msg_size, msgs, chunk * box->msg_size);
+	if (chunk < n)
+		memcpy(ring->buf, msgs + chunk * box->msg_size,
+		       (n - chunk) * box->msg_size);
+	ring->count += n;
+}
+
+/* copy n messages out of ring, caller must check there are enough */
+static void ring_read(struct mbox *box, uint8_t *msgs, size_t n)
+{
+	struct mbox_ring *ring = box->ring;
+	size_t chunk = ring->capacity - ring->head;
+
+	if (chunk > n)
+		chunk = n;
+	memcpy(msgs, ring->buf + ring->head * box->msg_size,
+	       chunk * box->msg_size);
+	if (chunk < n)
+		memcpy(msgs + chunk * box->msg_size, ring->buf,
+		       (n - chunk) * box->msg_size);
+	ring->head = (ring->head + n) % ring->capacity;
+	ring->count -= n;
+}
+
+/* called with ring lock held */
+static int ring_push_locked(struct mbox *box, const void *msgs, size_t n)
+{
+	struct mbox_ring *ring = box->ring;
+	size_t room = ring->capacity - ring->count;
+
+	if (room == 0)
+		return -EAGAIN;
+	if (n > room)
+		n = room;
+
+	ring_write(box, msgs, n);
+
+	/* edge triggered: only the first message makes the fd readable */
+	if (ring->count == n)
+		ring_notify(box);
+	return (int)n;
+}
+
+static int ring_push(struct mbox *box, const void *msgs, size_t n)
+{
+	int ret;
+
+	pthread_mutex_lock(&box->ring->lock);
+	ret = ring_push_locked(box, msgs, n);
+	pthread_mutex_unlock(&box->ring->lock);
+	return ret;
+}
+
+static int ring_push_block(struct mbox *box, const void *msg,
+			   unsigned int timeout_ms)
+{
+	struct mbox_ring *ring = box->ring;
+	struct timeval tv_now;
+	struct timespec ts_now;
+	struct timespec ts_abs;
+	int ret = 0;
+
+	if (timeout_ms > 0) {
+		ret = gettimeofday(&tv_now, NULL);
+		if (ret) {
+			ret = -errno;
+			ULOG_ERRNO("gettimeofday()", -ret);
+			return ret;
+		}
+		time_timeval_to_timespec(&tv_now, &ts_now);
+		time_timespec_add_us(&ts_now, (int64_t)timeout_ms * 1000,
+				     &ts_abs);
+	}
+
+	pthread_mutex_lock(&ring->lock);
+
+	/* block until a message can be queued */
+	while (ring->count == ring->capacity) {
+		if (timeout_ms == 0)
+			ret = -pthread_cond_wait(&ring->cond, &ring->lock);
+		else
+			ret = -pthread_cond_timedwait(&ring->cond, &ring->lock,
+						      &ts_abs);
+		if (ret < 0)
+			goto out;
+	}
+
+	ret = ring_push_locked(box, msg, 1);
+out:
+	pthread_mutex_unlock(&ring->lock);
+	return ret < 0 ? ret : 0;
+}
+
+static int ring_peek(struct mbox *box, void *msgs, size_t max)
+{
+	struct mbox_ring *ring = box->ring;
+	int was_full;
+	size_t n;
+
+	pthread_mutex_lock(&ring->lock);
+	if (ring->count == 0) {
+		pthread_mutex_unlock(&ring->lock);
+		return -EAGAIN;
+	}
+
+	was_full = ring->count == ring->capacity;
+	n = ring->count < max ? ring->count : max;
+	ring_read(box, msgs, n);
+
+	/* fd stays readable as long as messages are queued */
+	if (ring->count == 0)
+		ring_drain(box);
+	if (was_full)
+		pthread_cond_broadcast(&ring->cond);
+	pthread_mutex_unlock(&ring->lock);
+	return (int)n;
+}
+
 struct mbox *mbox_new(size_t msg_size)
 {
 	struct mbox *box;
@@ -84,13 +266,84 @@ struct mbox *mbox_new(size_t msg_size)
 	return box;
 }
 
+struct mbox *mbox_new_ring(size_t msg_size, size_t capacity)
+{
+	struct mbox *box;
+#ifndef __linux__
+	int i, ret;
+#endif
+
+	if (msg_size == 0 || capacity == 0 || capacity > INT_MAX ||
+	    capacity > SIZE_MAX / msg_size)
+		return NULL;
+
+	/* allocate mbox */
+	box = calloc(1, sizeof(*box));
+	if (!box)
+		return NULL;
+	box->fds[0] = -1;
+	box->fds[1] = -1;
+
+	box->ring = calloc(1, sizeof(*box->ring));
+	if (!box->ring)
+		goto error;
+
+	box->ring->buf = malloc(capacity * msg_size);
+	if (!box->ring->buf)
+		goto error;
+
+	/* create notification fd, only used for wakeups */
+#ifdef __linux__
+	box->fds[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (box->fds[0] < 0)
+		goto error;
+	box->fds[1] = box->fds[0];
+#else
+	ret = pipe(box->fds);
+	if (ret < 0) {
+		box->fds[0] = -1;
+		box->fds[1] = -1;
+		goto error;
+	}
+
+	for (i = 0; i < 2; i++) {
+		fd_add_flags(box->fds[i], O_NONBLOCK);
+		fd_set_close_on_exec(box->fds[i]);
+	}
+#endif
+
+	pthread_mutex_init(&box->ring->lock, NULL);
+	pthread_cond_init(&box->ring->cond, NULL);
+	box->ring->capacity = capacity;
+	box->msg_size = msg_size;
+	return box;
+
+error:
+	if (box->fds[0] >= 0)
+		close(box->fds[0]);
+	if (box->fds[1] >= 0 && box->fds[1] != box->fds[0])
+		close(box->fds[1]);
+	if (box->ring)
+		free(box->ring->buf);
+	free(box->ring);
+	free(box);
+	return NULL;
+}
+
 void mbox_destroy(struct mbox *box)
 {
 	if (!box)
 		return;
 
 	close(box->fds[0]);
-	close(box->fds[1]);
+	if (box->fds[1] != box->fds[0])
+		close(box->fds[1]);
+	if (box->ring) {
+		pthread_cond_destroy(&box->ring->cond);
+		pthread_mutex_destroy(&box->ring->lock);
+		free(box->ring->buf);
+		free(box->ring);
+	}
 	free(box);
 }
 
@@ -106,6 +359,11 @@ int mbox_push(struct mbox *box, const void *msg)
 	if (!msg || !box)
 		return -EINVAL;
 
+	if (box->ring) {
+		ret = ring_push(box, msg, 1);
+		return (ret < 0) ? (int)ret : 0;
+	}
+
 	/* write without blocking */
 	do {
 		ret = write(box->fds[1], msg, box->msg_size);
@@ -128,6 +386,9 @@ int mbox_push_block(struct mbox *box, const void *msg, unsigned int timeout_ms)
 		return -EINVAL;
 	timeout = (timeout_ms == 0) ? -1 : (int)timeout_ms;
 
+	if (box->ring)
+		return ring_push_block(box, msg, timeout_ms);
+
 	/* Block until we have at least PIPE_BUF bytes in the pipe */
 	do {
 		struct pollfd pfd = {
@@ -158,6 +419,11 @@ int mbox_peek(struct mbox *box, void *msg)
 	if (!msg || !box)
 		return -EINVAL;
 
+	if (box->ring) {
+		ret = ring_peek(box, msg, 1);
+		return (ret < 0) ? (int)ret : 0;
+	}
+
 	/* read without blocking */
 	do {
 		ret = read(box->fds[0], msg, box->msg_size);
@@ -172,6 +438,87 @@ int mbox_peek(struct mbox *box, void *msg)
 	return (ret < 0) ? -errno : 0;
 }
 
+int mbox_push_batch(struct mbox *box, const void *msgs, size_t n)
+{
+	const uint8_t *p = msgs;
+	size_t done = 0, count;
+	ssize_t ret;
+
+	if (!msgs || !box || n == 0)
+		return -EINVAL;
+	if (n > INT_MAX)
+		n = INT_MAX;
+
+	if (box->ring)
+		return ring_push(box, msgs, n);
+
+	/* writes of at most PIPE_BUF bytes are atomic, so only whole
+	 * messages are ever queued */
+	count = PIPE_BUF / box->msg_size;
+	while (done < n) {
+		if (count > n - done)
+			count = n - done;
+
+		do {
+			ret = write(box->fds[1], p + done * box->msg_size,
+				    count * box->msg_size);
+		} while (ret == -1 && errno == EINTR);
+
+		if (ret >= 0) {
+			done += count;
+			continue;
+		}
+		if (errno != EAGAIN)
+			return done > 0 ? (int)done : -errno;
+
+		/* not enough room for the whole chunk, try a smaller one */
+		if (count == 1)
+			break;
+		count /= 2;
+	}
+
+	return done > 0 ? (int)done : -EAGAIN;
+}
+
+int mbox_peek_batch(struct mbox *box, void *msgs, size_t max)
+{
+	size_t len;
+	ssize_t ret;
+
+	if (!msgs || !box || max == 0)
+		return -EINVAL;
+	if (max > INT_MAX)
+		max = INT_MAX;
+
+	if (box->ring)
+		return ring_peek(box, msgs, max);
+
+	if (max > SSIZE_MAX / box->msg_size)
+		max = SSIZE_MAX / box->msg_size;
+
+	/* read without blocking */
+	do {
+		ret = read(box->fds[0], msgs, max * box->msg_size);
+	} while (ret == -1 && errno == EINTR);
+
+	/* check eof */
+	if (ret == 0)
+		return -EPIPE;
+	if (ret < 0)
+		return -errno;
+
+	/* writers only queue whole messages, so a read can not end in the
+	 * middle of one: if it does, the pipe content can not be trusted */
+	len = (size_t)ret;
+	if (len % box->msg_size != 0) {
+		ULOGE("partial message read: %zu bytes for %zu bytes messages",
+		      len, box->msg_size);
+		return -EIO;
+	}
+
+	return (int)(len / box->msg_size);
+}
+
 #else /* _WIN32 */
 
 #include <winsock2.h>
@@ -272,6 +619,15 @@ error:
 	return NULL;
 }
 
+struct mbox *mbox_new_ring(size_t msg_size, size_t capacity)
+{
+	(void)msg_size;
+	(void)capacity;
+
+	/* not supported */
+	return NULL;
+}
+
 void mbox_destroy(struct mbox *box)
 {
 	if (!box)
@@ -404,4 +760,46 @@ int mbox_peek(struct mbox *box, void *msg)
 	return 0;
 }
 
+int mbox_push_batch(struct mbox *box, const void *msgs, size_t n)
+{
+	const uint8_t *p = msgs;
+	size_t done;
+	int ret;
+
+	if (!msgs || !box || n == 0)
+		return -EINVAL;
+	if (n > INT_MAX)
+		n = INT_MAX;
+
+	/* a stream socket does not guarantee atomic writes, so push
+	 * messages one by one */
+	for (done = 0; done < n; done++) {
+		ret = mbox_push(box, p + done * box->msg_size);
+		if (ret < 0)
+			return done > 0 ? (int)done : ret;
+	}
+
+	return (int)done;
+}
+
+int mbox_peek_batch(struct mbox *box, void *msgs, size_t max)
+{
+	uint8_t *p = msgs;
+	size_t done;
+	int ret;
+
+	if (!msgs || !box || max == 0)
+		return -EINVAL;
+	if (max > INT_MAX)
+		max = INT_MAX;
+
+	for (done = 0; done < max; done++) {
+		ret = mbox_peek(box, p + done * box->msg_size);
+		if (ret < 0)
+			return done > 0 ? (int)done : ret;
+	}
+
+	return (int)done;
+}
+
 #endif /* _WIN32 */
@@ -0,0 +1,333 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file mpmc.c
+ *
+ * @brief bounded multi producer multi consumer queue
+ *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define ULOG_TAG futils_mpmc
+#include <ulog.h>
+ULOG_DECLARE_TAG(futils_mpmc);
+
+#include "futils/mpmc.h"
+#include "futils/timetools.h"
+
+#define MPMC_CACHE_LINE 64
+
+struct mpmc_cell {
+	size_t seq;		/* lap sequence number */
+	uint8_t data[];		/* element */
+};
+
+struct futils_mpmc {
+	/* next position to push, shared by producers */
+	size_t enqueue_pos;
+	char pad0[MPMC_CACHE_LINE - sizeof(size_t)];
+	/* next position to pop, shared by consumers */
+	size_t dequeue_pos;
+	char pad1[MPMC_CACHE_LINE - sizeof(size_t)];
+	/* number of threads blocked in push and pop */
+	int push_waiters;
+	int pop_waiters;
+	char pad2[MPMC_CACHE_LINE - 2 * sizeof(int)];
+
+	/* slow path */
+	pthread_mutex_t lock;
+	pthread_cond_t not_full;
+	pthread_cond_t not_empty;
+
+	/* read only after creation */
+	uint8_t *cells;
+	size_t mask;
+	size_t elem_size;
+	size_t cell_size;
+};
+
+static inline struct mpmc_cell *mpmc_cell(const struct futils_mpmc *q,
+					  size_t pos)
+{
+	return (struct mpmc_cell *)(q->cells + (pos & q->mask) * q->cell_size);
+}
+
+struct futils_mpmc *futils_mpmc_new(size_t elem_size, size_t size)
+{
+	struct futils_mpmc *q;
+	size_t n = 2, i;
+
+	if (elem_size == 0 || size == 0 ||
+	    elem_size > SIZE_MAX / 2 - sizeof(struct mpmc_cell))
+		return NULL;
+
+	while (n < size) {
+		if (n > SIZE_MAX / 2)
+			return NULL;
+		n *= 2;
+	}
+
+	q = calloc(1, sizeof(*q));
+	if (!q)
+		return NULL;
+
+	/* keep cells aligned for the sequence number */
+	q->elem_size = elem_size;
+	q->cell_size = (sizeof(struct mpmc_cell) + elem_size +
+			sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+	if (n > SIZE_MAX / q->cell_size)
+		goto error;
+
+	q->cells = malloc(n * q->cell_size);
+	if (!q->cells)
+		goto error;
+
+	q->mask = n - 1;
+	for (i = 0; i < n; i++)
+		mpmc_cell(q, i)->seq = i;
+
+	pthread_mutex_init(&q->lock, NULL);
+	pthread_cond_init(&q->not_full, NULL);
+	pthread_cond_init(&q->not_empty, NULL);
+	return q;
+
+error:
+	free(q);
+	return NULL;
+}
+
+void futils_mpmc_destroy(struct futils_mpmc *q)
+{
+	if (!q)
+		return;
+
+	pthread_cond_destroy(&q->not_empty);
+	pthread_cond_destroy(&q->not_full);
+	pthread_mutex_destroy(&q->lock);
+	free(q->cells);
+	free(q);
+}
+
+/* wake threads blocked on cond, if any; pairs with the waiters increment
+ * of mpmc_wait(): either the waiter sees the push/pop done before, or we
+ * see it waiting */
+static inline void mpmc_wakeup(struct futils_mpmc *q, int *waiters,
+			       pthread_cond_t *cond)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(waiters, __ATOMIC_RELAXED) == 0)
+		return;
+
+	pthread_mutex_lock(&q->lock);
+	pthread_cond_broadcast(cond);
+	pthread_mutex_unlock(&q->lock);
+}
+
+static int mpmc_push(struct futils_mpmc *q, const void *elem)
+{
+	struct mpmc_cell *cell;
+	size_t pos, seq;
+	intptr_t dif;
+
+	pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+	for (;;) {
+		cell = mpmc_cell(q, pos);
+		seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+		dif = (intptr_t)seq - (intptr_t)pos;
+		if (dif == 0) {
+			/* cell is free for this lap, try to claim it */
+			if (__atomic_compare_exchange_n(&q->enqueue_pos, &pos,
+							pos + 1, 1,
+							__ATOMIC_RELAXED,
+							__ATOMIC_RELAXED))
+				break;
+		} else if (dif < 0) {
+			/* cell not yet popped from previous lap: full */
+			return -EAGAIN;
+		} else {
+			pos = __atomic_load_n(&q->enqueue_pos,
+					      __ATOMIC_RELAXED);
+		}
+	}
+
+	memcpy(cell->data, elem, q->elem_size);
+	__atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+static int mpmc_pop(struct futils_mpmc *q, void *elem)
+{
+	struct mpmc_cell *cell;
+	size_t pos, seq;
+	intptr_t dif;
+
+	pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+	for (;;) {
+		cell = mpmc_cell(q, pos);
+		seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+		dif = (intptr_t)seq - (intptr_t)(pos + 1);
+		if (dif == 0) {
+			/* cell is written for this lap, try to claim it */
+			if (__atomic_compare_exchange_n(&q->dequeue_pos, &pos,
+							pos + 1, 1,
+							__ATOMIC_RELAXED,
+							__ATOMIC_RELAXED))
+				break;
+		} else if (dif < 0) {
+			/* cell not yet pushed for this lap: empty */
+			return -EAGAIN;
+		} else {
+			pos = __atomic_load_n(&q->dequeue_pos,
+					      __ATOMIC_RELAXED);
+		}
+	}
+
+	memcpy(elem, cell->data, q->elem_size);
+	/* free cell for next lap */
+	__atomic_store_n(&cell->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+	return 0;
+}
+
+int futils_mpmc_try_push(struct futils_mpmc *q, const void *elem)
+{
+	int ret;
+
+	if (!q || !elem)
+		return -EINVAL;
+
+	ret = mpmc_push(q, elem);
+	if (ret == 0)
+		mpmc_wakeup(q, &q->pop_waiters, &q->not_empty);
+	return ret;
+}
+
+int futils_mpmc_try_pop(struct futils_mpmc *q, void *elem)
+{
+	int ret;
+
+	if (!q || !elem)
+		return -EINVAL;
+
+	ret = mpmc_pop(q, elem);
+	if (ret == 0)
+		mpmc_wakeup(q, &q->push_waiters, &q->not_full);
+	return ret;
+}
+
+static int mpmc_deadline(unsigned int timeout_ms, struct timespec *ts_abs)
+{
+	struct timeval tv_now;
+	struct timespec ts_now;
+	int res;
+
+	res = gettimeofday(&tv_now, NULL);
+	if (res) {
+		res = -errno;
+		ULOG_ERRNO("gettimeofday()", -res);
+		return res;
+	}
+	time_timeval_to_timespec(&tv_now, &ts_now);
+	return time_timespec_add_us(&ts_now, (int64_t)timeout_ms * 1000,
+				    ts_abs);
+}
+
+/* slow path of blocking calls: retry op under lock until it succeeds, the
+ * lock making sure a wakeup is not lost between retry and wait */
+static int mpmc_wait(struct futils_mpmc *q, int (*op)(struct futils_mpmc *,
+						      void *),
+		     void *elem, int *waiters, pthread_cond_t *cond,
+		     unsigned int timeout_ms)
+{
+	struct timespec ts_abs;
+	int ret;
+
+	if (timeout_ms > 0) {
+		ret = mpmc_deadline(timeout_ms, &ts_abs);
+		if (ret < 0)
+			return ret;
+	}
+
+	pthread_mutex_lock(&q->lock);
+	__atomic_fetch_add(waiters, 1, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	for (;;) {
+		ret = op(q, elem);
+		if (ret != -EAGAIN)
+			break;
+		if (timeout_ms == 0)
+			ret = -pthread_cond_wait(cond, &q->lock);
+		else
+			ret = -pthread_cond_timedwait(cond, &q->lock, &ts_abs);
+		if (ret < 0)
+			break;
+	}
+	__atomic_fetch_sub(waiters, 1, __ATOMIC_RELAXED);
+	pthread_mutex_unlock(&q->lock);
+	return ret;
+}
+
+static int mpmc_push_op(struct futils_mpmc *q, void *elem)
+{
+	return mpmc_push(q, elem);
+}
+
+int futils_mpmc_push_block(struct futils_mpmc *q, const void *elem,
+			   unsigned int timeout_ms)
+{
+	int ret;
+
+	if (!q || !elem)
+		return -EINVAL;
+
+	ret = mpmc_push(q, elem);
+	if (ret == -EAGAIN)
+		ret = mpmc_wait(q, &mpmc_push_op, (void *)elem,
+				&q->push_waiters, &q->not_full, timeout_ms);
+	if (ret == 0)
+		mpmc_wakeup(q, &q->pop_waiters, &q->not_empty);
+	return ret;
+}
+
+int futils_mpmc_pop_block(struct futils_mpmc *q, void *elem,
+			  unsigned int timeout_ms)
+{
+	int ret;
+
+	if (!q || !elem)
+		return -EINVAL;
+
+	ret = mpmc_pop(q, elem);
+	if (ret == -EAGAIN)
+		ret = mpmc_wait(q, &mpmc_pop, elem, &q->pop_waiters,
+				&q->not_empty, timeout_ms);
+	if (ret == 0)
+		mpmc_wakeup(q, &q->push_waiters, &q->not_full);
+	return ret;
+}
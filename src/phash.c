@@ -0,0 +1,321 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file phash.c
+ *
+ * @brief immutable minimal perfect hash table
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/phash.h"
+
+/* average number of keys per bucket */
+#define PHASH_BUCKET_KEYS 4
+
+/**
+ * minimum number of displacements tried for a bucket before changing seed,
+ * last buckets need about count attempts to find a free slot
+ */
+#define PHASH_MIN_DISP (UINT32_C(1) << 16)
+
+/* number of seeds tried before giving up */
+#define PHASH_MAX_ATTEMPTS 8
+
+/* map a 32bit hash value to [0, n) without division */
+static inline uint32_t phash_reduce(uint32_t h, uint32_t n)
+{
+	return (uint32_t)(((uint64_t)h * n) >> 32);
+}
+
+static inline uint32_t phash_bucket(uint32_t key, uint32_t seed,
+				    uint32_t nbuckets)
+{
+	return phash_reduce(futils_hash_u32(key ^ seed), nbuckets);
+}
+
+static inline uint32_t phash_slot(uint32_t key, uint32_t disp, uint32_t count)
+{
+	/* splitmix64 finalizer on key and displacement */
+	uint64_t x = ((uint64_t)disp << 32) | key;
+
+	x ^= x >> 30;
+	x *= UINT64_C(0xbf58476d1ce4e5b9);
+	x ^= x >> 27;
+	x *= UINT64_C(0x94d049bb133111eb);
+	x ^= x >> 31;
+	return phash_reduce((uint32_t)x, count);
+}
+
+struct phash_bucket {
+	uint32_t idx;		/* bucket index */
+	uint32_t start;		/* first key in sorted keys */
+	uint32_t len;		/* number of keys */
+};
+
+/* sort buckets by decreasing size, larger ones being harder to place */
+static int phash_bucket_cmp(const void *a, const void *b)
+{
+	const struct phash_bucket *ba = a;
+	const struct phash_bucket *bb = b;
+
+	if (ba->len != bb->len)
+		return ba->len < bb->len ? 1 : -1;
+	return ba->idx < bb->idx ? -1 : ba->idx > bb->idx;
+}
+
+/* find a displacement for a bucket, mark its slots as taken */
+static int phash_place(const struct phash_bucket *b,
+		       const struct futils_phash_slot *keys, uint32_t count,
+		       uint8_t *taken, uint32_t *slot_idx, uint32_t *_disp)
+{
+	uint64_t max_disp;
+	uint32_t disp, i, j;
+
+	max_disp = (uint64_t)count * 16;
+	if (max_disp < PHASH_MIN_DISP)
+		max_disp = PHASH_MIN_DISP;
+	else if (max_disp > UINT32_MAX)
+		max_disp = UINT32_MAX;
+
+	for (disp = 0; disp < max_disp; disp++) {
+		for (i = 0; i < b->len; i++) {
+			slot_idx[i] = phash_slot(keys[b->start + i].key, disp,
+						 count);
+			if (taken[slot_idx[i]])
+				break;
+			taken[slot_idx[i]] = 1;
+		}
+
+		if (i == b->len) {
+			*_disp = disp;
+			return 0;
+		}
+
+		/* release slots taken by this attempt */
+		for (j = 0; j < i; j++)
+			taken[slot_idx[j]] = 0;
+	}
+
+	return -EAGAIN;
+}
+
+static int phash_try(struct futils_phash *phash,
+		     const struct futils_phash_slot *entries,
+		     struct phash_bucket *buckets,
+		     struct futils_phash_slot *keys, uint8_t *taken,
+		     uint32_t *disp, struct futils_phash_slot *slots)
+{
+	uint32_t count = phash->count;
+	uint32_t nbuckets = phash->nbuckets;
+	uint32_t slot_idx[256];
+	uint32_t i, j, b;
+	int ret;
+
+	/* counting sort of entries by bucket */
+	for (b = 0; b < nbuckets; b++) {
+		buckets[b].idx = b;
+		buckets[b].len = 0;
+	}
+	for (i = 0; i < count; i++)
+		buckets[phash_bucket(entries[i].key, phash->seed,
+				     nbuckets)].len++;
+
+	j = 0;
+	for (b = 0; b < nbuckets; b++) {
+		/* too many keys in a bucket, try another seed */
+		if (buckets[b].len > sizeof(slot_idx) / sizeof(slot_idx[0]))
+			return -EAGAIN;
+		buckets[b].start = j;
+		j += buckets[b].len;
+		buckets[b].len = 0;
+	}
+	for (i = 0; i < count; i++) {
+		b = phash_bucket(entries[i].key, phash->seed, nbuckets);
+		keys[buckets[b].start + buckets[b].len++] = entries[i];
+	}
+
+	qsort(buckets, nbuckets, sizeof(*buckets), &phash_bucket_cmp);
+
+	memset(taken, 0, count);
+	memset(disp, 0, nbuckets * sizeof(*disp));
+	for (b = 0; b < nbuckets && buckets[b].len > 0; b++) {
+		ret = phash_place(&buckets[b], keys, count, taken, slot_idx,
+				  &disp[buckets[b].idx]);
+		if (ret < 0)
+			return ret;
+
+		for (i = 0; i < buckets[b].len; i++)
+			slots[slot_idx[i]] = keys[buckets[b].start + i];
+	}
+
+	return 0;
+}
+
+int futils_phash_build(struct futils_phash *phash, const struct hash *hash)
+{
+	struct futils_phash_slot *entries = NULL, *keys = NULL, *slots = NULL;
+	struct phash_bucket *buckets = NULL;
+	struct hash_entry *entry;
+	uint8_t *taken = NULL;
+	uint32_t *disp = NULL;
+	uint32_t count, nbuckets, attempt;
+	int ret;
+
+	if (!phash || !hash)
+		return -EINVAL;
+
+	memset(phash, 0, sizeof(*phash));
+
+	/* data of intrusive entries is not a pointer stored in the entry */
+	count = 0;
+	list_walk_entry_forward(&hash->entries, entry, node) {
+		if (entry->is_intrusive)
+			return -EINVAL;
+		count++;
+	}
+
+	nbuckets = (count + PHASH_BUCKET_KEYS - 1) / PHASH_BUCKET_KEYS;
+	if (nbuckets == 0)
+		nbuckets = 1;
+
+	disp = calloc(nbuckets, sizeof(*disp));
+	buckets = calloc(nbuckets, sizeof(*buckets));
+	entries = calloc(count, sizeof(*entries));
+	keys = calloc(count, sizeof(*keys));
+	slots = calloc(count, sizeof(*slots));
+	taken = calloc(count, sizeof(*taken));
+	if (!disp || !buckets || (count > 0 &&
+	    (!entries || !keys || !slots || !taken))) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	count = 0;
+	list_walk_entry_forward(&hash->entries, entry, node) {
+		entries[count].key = entry->key;
+		entries[count].is_const = entry->is_const ? 1 : 0;
+		entries[count].const_data = entry->const_data;
+		count++;
+	}
+
+	phash->nbuckets = nbuckets;
+	phash->count = count;
+
+	ret = -EAGAIN;
+	for (attempt = 0; attempt < PHASH_MAX_ATTEMPTS && ret < 0; attempt++) {
+		phash->seed = futils_hash_u32(attempt + 1);
+		ret = phash_try(phash, entries, buckets, keys, taken, disp,
+				slots);
+	}
+	if (ret < 0)
+		goto out;
+
+	phash->disp = disp;
+	phash->slots = slots;
+	disp = NULL;
+	slots = NULL;
+
+out:
+	if (ret < 0)
+		memset(phash, 0, sizeof(*phash));
+	free(disp);
+	free(buckets);
+	free(entries);
+	free(keys);
+	free(slots);
+	free(taken);
+	return ret;
+}
+
+int futils_phash_destroy(struct futils_phash *phash)
+{
+	if (!phash)
+		return -EINVAL;
+
+	free((void *)phash->disp);
+	free((void *)phash->slots);
+	memset(phash, 0, sizeof(*phash));
+	return 0;
+}
+
+static int phash_find(const struct futils_phash *phash, uint32_t key,
+		      const struct futils_phash_slot **_slot)
+{
+	const struct futils_phash_slot *slot;
+	uint32_t b;
+
+	if (phash->count == 0)
+		return -ENOENT;
+
+	b = phash_bucket(key, phash->seed, phash->nbuckets);
+	slot = &phash->slots[phash_slot(key, phash->disp[b], phash->count)];
+	if (slot->key != key)
+		return -ENOENT;
+
+	*_slot = slot;
+	return 0;
+}
+
+int futils_phash_lookup(const struct futils_phash *phash, uint32_t key,
+			void **data)
+{
+	const struct futils_phash_slot *slot;
+	int ret;
+
+	if (!phash)
+		return -EINVAL;
+
+	ret = phash_find(phash, key, &slot);
+	if (ret < 0)
+		return ret;
+
+	if (slot->is_const)
+		return -EPERM;
+
+	if (data)
+		*data = slot->data;
+
+	return 0;
+}
+
+int futils_phash_lookup_const(const struct futils_phash *phash, uint32_t key,
+			      const void **data)
+{
+	const struct futils_phash_slot *slot;
+	int ret;
+
+	if (!phash)
+		return -EINVAL;
+
+	ret = phash_find(phash, key, &slot);
+	if (ret < 0)
+		return ret;
+
+	if (data)
+		*data = slot->const_data;
+
+	return 0;
+}
@@ -0,0 +1,356 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file rbtree.c
+ *
+ * @brief intrusive red-black tree
+ *
+ *****************************************************************************/
+
+#include "futils/rbtree.h"
+
+static inline int rbtree_is_red(const struct futils_rbnode *node)
+{
+	return node && node->red;
+}
+
+/* make repl take the place of old as child of parent */
+static void rbtree_replace_child(struct futils_rbtree *tree,
+				 struct futils_rbnode *parent,
+				 struct futils_rbnode *old,
+				 struct futils_rbnode *repl)
+{
+	if (!parent)
+		tree->root = repl;
+	else if (parent->left == old)
+		parent->left = repl;
+	else
+		parent->right = repl;
+}
+
+static void rbtree_rotate_left(struct futils_rbtree *tree,
+			       struct futils_rbnode *x)
+{
+	struct futils_rbnode *y = x->right;
+
+	x->right = y->left;
+	if (y->left)
+		y->left->parent = x;
+	y->parent = x->parent;
+	rbtree_replace_child(tree, x->parent, x, y);
+	y->left = x;
+	x->parent = y;
+}
+
+static void rbtree_rotate_right(struct futils_rbtree *tree,
+				struct futils_rbnode *x)
+{
+	struct futils_rbnode *y = x->left;
+
+	x->left = y->right;
+	if (y->right)
+		y->right->parent = x;
+	y->parent = x->parent;
+	rbtree_replace_child(tree, x->parent, x, y);
+	y->right = x;
+	x->parent = y;
+}
+
+static void rbtree_insert_fixup(struct futils_rbtree *tree,
+				struct futils_rbnode *node)
+{
+	struct futils_rbnode *parent, *gparent, *uncle;
+
+	while ((parent = node->parent) && parent->red) {
+		/* parent is red so it is not the root */
+		gparent = parent->parent;
+
+		if (parent == gparent->left) {
+			uncle = gparent->right;
+			if (rbtree_is_red(uncle)) {
+				parent->red = 0;
+				uncle->red = 0;
+				gparent->red = 1;
+				node = gparent;
+				continue;
+			}
+			if (node == parent->right) {
+				rbtree_rotate_left(tree, parent);
+				node = parent;
+				parent = node->parent;
+			}
+			parent->red = 0;
+			gparent->red = 1;
+			rbtree_rotate_right(tree, gparent);
+		} else {
+			uncle = gparent->left;
+			if (rbtree_is_red(uncle)) {
+				parent->red = 0;
+				uncle->red = 0;
+				gparent->red = 1;
+				node = gparent;
+				continue;
+			}
+			if (node == parent->left) {
+				rbtree_rotate_right(tree, parent);
+				node = parent;
+				parent = node->parent;
+			}
+			parent->red = 0;
+			gparent->red = 1;
+			rbtree_rotate_left(tree, gparent);
+		}
+	}
+
+	tree->root->red = 0;
+}
+
+void futils_rbtree_insert(struct futils_rbtree *tree,
+			  struct futils_rbnode *node, futils_rbtree_cmp_t cmp)
+{
+	struct futils_rbnode **link = &tree->root;
+	struct futils_rbnode *parent = NULL;
+
+	while (*link) {
+		parent = *link;
+		if (cmp(node, parent) < 0)
+			link = &parent->left;
+		else
+			link = &parent->right;
+	}
+
+	node->parent = parent;
+	node->left = NULL;
+	node->right = NULL;
+	node->red = 1;
+	*link = node;
+
+	rbtree_insert_fixup(tree, node);
+}
+
+/**
+ * restore tree properties after removal of a black node, node being the
+ * child (possibly NULL) that took its place under parent
+ */
+static void rbtree_erase_fixup(struct futils_rbtree *tree,
+			       struct futils_rbnode *node,
+			       struct futils_rbnode *parent)
+{
+	struct futils_rbnode *sibling;
+
+	while (node != tree->root && !rbtree_is_red(node)) {
+		if (node == parent->left) {
+			sibling = parent->right;
+			if (sibling->red) {
+				sibling->red = 0;
+				parent->red = 1;
+				rbtree_rotate_left(tree, parent);
+				sibling = parent->right;
+			}
+			if (!rbtree_is_red(sibling->left) &&
+			    !rbtree_is_red(sibling->right)) {
+				sibling->red = 1;
+				node = parent;
+				parent = node->parent;
+				continue;
+			}
+			if (!rbtree_is_red(sibling->right)) {
+				sibling->left->red = 0;
+				sibling->red = 1;
+				rbtree_rotate_right(tree, sibling);
+				sibling = parent->right;
+			}
+			sibling->red = parent->red;
+			parent->red = 0;
+			sibling->right->red = 0;
+			rbtree_rotate_left(tree, parent);
+		} else {
+			sibling = parent->left;
+			if (sibling->red) {
+				sibling->red = 0;
+				parent->red = 1;
+				rbtree_rotate_right(tree, parent);
+				sibling = parent->left;
+			}
+			if (!rbtree_is_red(sibling->left) &&
+			    !rbtree_is_red(sibling->right)) {
+				sibling->red = 1;
+				node = parent;
+				parent = node->parent;
+				continue;
+			}
+			if (!rbtree_is_red(sibling->left)) {
+				sibling->right->red = 0;
+				sibling->red = 1;
+				rbtree_rotate_left(tree, sibling);
+				sibling = parent->left;
+			}
+			sibling->red = parent->red;
+			parent->red = 0;
+			sibling->left->red = 0;
+			rbtree_rotate_right(tree, parent);
+		}
+		node = tree->root;
+		break;
+	}
+
+	if (node)
+		node->red = 0;
+}
+
+void futils_rbtree_erase(struct futils_rbtree *tree,
+			 struct futils_rbnode *node)
+{
+	struct futils_rbnode *removed, *child, *parent;
+	int removed_red;
+
+	/* node with two children is replaced by its successor */
+	removed = node;
+	if (node->left && node->right) {
+		removed = node->right;
+		while (removed->left)
+			removed = removed->left;
+	}
+
+	/* unlink removed, which has at most one child */
+	child = removed->left ? removed->left : removed->right;
+	parent = removed->parent;
+	if (child)
+		child->parent = parent;
+	rbtree_replace_child(tree, parent, removed, child);
+	removed_red = removed->red;
+
+	if (removed != node) {
+		/* put successor in place of node */
+		if (parent == node)
+			parent = removed;
+		removed->left = node->left;
+		removed->right = node->right;
+		removed->parent = node->parent;
+		removed->red = node->red;
+		rbtree_replace_child(tree, node->parent, node, removed);
+		if (removed->left)
+			removed->left->parent = removed;
+		if (removed->right)
+			removed->right->parent = removed;
+	}
+
+	if (!removed_red)
+		rbtree_erase_fixup(tree, child, parent);
+
+	node->parent = NULL;
+	node->left = NULL;
+	node->right = NULL;
+}
+
+struct futils_rbnode *futils_rbtree_lower_bound(
+		const struct futils_rbtree *tree, futils_rbtree_key_cmp_t cmp,
+		const void *key)
+{
+	struct futils_rbnode *node = tree->root;
+	struct futils_rbnode *res = NULL;
+
+	while (node) {
+		if (cmp(node, key) >= 0) {
+			res = node;
+			node = node->left;
+		} else {
+			node = node->right;
+		}
+	}
+
+	return res;
+}
+
+struct futils_rbnode *futils_rbtree_find(const struct futils_rbtree *tree,
+					 futils_rbtree_key_cmp_t cmp,
+					 const void *key)
+{
+	struct futils_rbnode *node;
+
+	node = futils_rbtree_lower_bound(tree, cmp, key);
+	if (node && cmp(node, key) != 0)
+		return NULL;
+
+	return node;
+}
+
+struct futils_rbnode *futils_rbtree_first(const struct futils_rbtree *tree)
+{
+	struct futils_rbnode *node = tree->root;
+
+	if (!node)
+		return NULL;
+	while (node->left)
+		node = node->left;
+	return node;
+}
+
+struct futils_rbnode *futils_rbtree_last(const struct futils_rbtree *tree)
+{
+	struct futils_rbnode *node = tree->root;
+
+	if (!node)
+		return NULL;
+	while (node->right)
+		node = node->right;
+	return node;
+}
+
+struct futils_rbnode *futils_rbtree_next(const struct futils_rbnode *node)
+{
+	struct futils_rbnode *parent;
+
+	if (node->right) {
+		node = node->right;
+		while (node->left)
+			node = node->left;
+		return (struct futils_rbnode *)node;
+	}
+
+	/* go up until coming from a left child */
+	while ((parent = node->parent) && node == parent->right)
+		node = parent;
+
+	return parent;
+}
+
+struct futils_rbnode *futils_rbtree_prev(const struct futils_rbnode *node)
+{
+	struct futils_rbnode *parent;
+
+	if (node->left) {
+		node = node->left;
+		while (node->right)
+			node = node->right;
+		return (struct futils_rbnode *)node;
+	}
+
+	/* go up until coming from a right child */
+	while ((parent = node->parent) && node == parent->left)
+		node = parent;
+
+	return parent;
+}
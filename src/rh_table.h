@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file rh_table.h
+ *
+ * @brief Robin Hood open addressing helpers
+ *
+ *****************************************************************************/
+
+#ifndef _FUTILS_RH_TABLE_H_
+#define _FUTILS_RH_TABLE_H_
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Robin Hood open addressing engine shared by flat tables.
+ *
+ * Tables are power of two sized arrays of caller defined slots, each slot
+ * storing its distance to initial bucket + 1 (dib), 0 meaning empty. Slot
+ * layout is described by an ops structure; when it is a static const, the
+ * compiler inlines accessors in these helpers.
+ */
+struct rh_table_ops {
+	/* slot size */
+	size_t slot_size;
+	/* get slot dib */
+	uint32_t (*get_dib)(const void *slot);
+	/* set slot dib */
+	void (*set_dib)(void *slot, uint32_t dib);
+	/* get hash value of slot key, used to get its initial bucket */
+	uint32_t (*get_hash)(const void *slot);
+	/* check if slot key is key, key format being defined by the table */
+	int (*match)(const void *slot, const void *key);
+};
+
+/* largest slot supported, for temporary copies */
+#define RH_TABLE_MAX_SLOT_SIZE 64
+
+static inline void *rh_table_slot(const struct rh_table_ops *ops, void *slots,
+				  uint32_t idx)
+{
+	return (uint8_t *)slots + (size_t)idx * ops->slot_size;
+}
+
+/**
+ * Robin Hood insertion of a slot known to be absent from the table:
+ * walk from the initial bucket and steal the place of any entry closer to
+ * its own initial bucket than the one being inserted.
+ */
+static inline void rh_table_place(const struct rh_table_ops *ops,
+				  void *slots, uint32_t mask, const void *slot)
+{
+	uint8_t cur[RH_TABLE_MAX_SLOT_SIZE];
+	uint8_t tmp[RH_TABLE_MAX_SLOT_SIZE];
+	uint32_t idx, dib;
+	void *s;
+
+	memcpy(cur, slot, ops->slot_size);
+	idx = ops->get_hash(cur) & mask;
+	dib = 1;
+
+	for (;;) {
+		s = rh_table_slot(ops, slots, idx);
+		if (ops->get_dib(s) == 0)
+			break;
+		if (ops->get_dib(s) < dib) {
+			ops->set_dib(cur, dib);
+			memcpy(tmp, s, ops->slot_size);
+			memcpy(s, cur, ops->slot_size);
+			memcpy(cur, tmp, ops->slot_size);
+			dib = ops->get_dib(cur);
+		}
+		idx = (idx + 1) & mask;
+		dib++;
+	}
+
+	ops->set_dib(cur, dib);
+	memcpy(s, cur, ops->slot_size);
+}
+
+/**
+ * insert all entries of an old table in a new empty one
+ */
+static inline void rh_table_rehash(const struct rh_table_ops *ops,
+				   void *slots, uint32_t mask,
+				   const void *old, size_t old_size)
+{
+	const void *s;
+	size_t i;
+
+	for (i = 0; i < old_size; i++) {
+		s = (const uint8_t *)old + i * ops->slot_size;
+		if (ops->get_dib(s) != 0)
+			rh_table_place(ops, slots, mask, s);
+	}
+}
+
+/**
+ * find the slot of a key
+ * @return 0 if found, -ENOENT if not
+ */
+static inline int rh_table_find(const struct rh_table_ops *ops,
+				const void *slots, uint32_t mask, uint32_t h,
+				const void *key, uint32_t *_idx)
+{
+	const void *s;
+	uint32_t idx, dib;
+
+	idx = h & mask;
+	for (dib = 1;; dib++) {
+		s = rh_table_slot(ops, (void *)slots, idx);
+
+		/* empty slot or an entry closer to its initial bucket than
+		 * the key would be: key is not in table */
+		if (ops->get_dib(s) < dib)
+			return -ENOENT;
+
+		if (ops->match(s, key)) {
+			*_idx = idx;
+			return 0;
+		}
+
+		idx = (idx + 1) & mask;
+	}
+}
+
+/**
+ * remove the entry of a slot, the entry must have been released
+ */
+static inline void rh_table_remove_at(const struct rh_table_ops *ops,
+				      void *slots, uint32_t mask, uint32_t idx)
+{
+	void *s, *n;
+	uint32_t next;
+
+	/* backward shift deletion: move following entries one slot back
+	 * until an empty slot or an entry in its initial bucket */
+	s = rh_table_slot(ops, slots, idx);
+	next = (idx + 1) & mask;
+	n = rh_table_slot(ops, slots, next);
+	while (ops->get_dib(n) > 1) {
+		memcpy(s, n, ops->slot_size);
+		ops->set_dib(s, ops->get_dib(n) - 1);
+		s = n;
+		next = (next + 1) & mask;
+		n = rh_table_slot(ops, slots, next);
+	}
+
+	memset(s, 0, ops->slot_size);
+}
+
+#endif /* !_FUTILS_RH_TABLE_H_ */
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file slotmap.c
+ *
+ * @brief generational slot map
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/slotmap.h"
+
+/* minimum capacity */
+#define SLOTMAP_MIN_SIZE 16
+
+/* end of free slots list */
+#define SLOTMAP_NO_SLOT UINT32_MAX
+
+struct slotmap_slot {
+	uint32_t gen;		/* generation, odd if slot is used */
+	uint32_t idx;		/* dense index if used, next free slot if not */
+};
+
+struct futils_slotmap {
+	struct slotmap_slot *slots;	/* handle index to dense index */
+	uint8_t *data;			/* dense elements */
+	uint32_t *dense_slot;		/* dense index to handle index */
+	size_t elem_size;		/* element size */
+	uint32_t count;			/* number of elements */
+	uint32_t capacity;		/* allocated elements and slots */
+	uint32_t free_slot;		/* first free slot */
+};
+
+static inline uint64_t slotmap_handle(uint32_t gen, uint32_t slot)
+{
+	return ((uint64_t)gen << 32) | slot;
+}
+
+static int slotmap_grow(struct futils_slotmap *map, uint32_t capacity)
+{
+	struct slotmap_slot *slots;
+	uint32_t *dense_slot;
+	uint8_t *data;
+	uint32_t i;
+
+	if (capacity > SIZE_MAX / map->elem_size)
+		return -ENOMEM;
+
+	data = realloc(map->data, (size_t)capacity * map->elem_size);
+	if (!data)
+		return -ENOMEM;
+	map->data = data;
+
+	dense_slot = realloc(map->dense_slot, capacity * sizeof(*dense_slot));
+	if (!dense_slot)
+		return -ENOMEM;
+	map->dense_slot = dense_slot;
+
+	slots = realloc(map->slots, capacity * sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+	map->slots = slots;
+
+	/* chain new slots in free list, lowest first */
+	for (i = capacity; i > map->capacity; i--) {
+		slots[i - 1].gen = 0;
+		slots[i - 1].idx = map->free_slot;
+		map->free_slot = i - 1;
+	}
+	map->capacity = capacity;
+
+	return 0;
+}
+
+struct futils_slotmap *futils_slotmap_new(size_t elem_size, size_t size)
+{
+	struct futils_slotmap *map;
+
+	if (elem_size == 0 || size >= UINT32_MAX / 2)
+		return NULL;
+
+	map = calloc(1, sizeof(*map));
+	if (!map)
+		return NULL;
+
+	map->elem_size = elem_size;
+	map->free_slot = SLOTMAP_NO_SLOT;
+	if (size < SLOTMAP_MIN_SIZE)
+		size = SLOTMAP_MIN_SIZE;
+
+	if (slotmap_grow(map, (uint32_t)size) < 0) {
+		futils_slotmap_destroy(map);
+		return NULL;
+	}
+
+	return map;
+}
+
+void futils_slotmap_destroy(struct futils_slotmap *map)
+{
+	if (!map)
+		return;
+
+	free(map->slots);
+	free(map->data);
+	free(map->dense_slot);
+	free(map);
+}
+
+int futils_slotmap_insert(struct futils_slotmap *map, const void *elem,
+			  uint64_t *handle)
+{
+	struct slotmap_slot *slot;
+	uint32_t idx;
+	void *dst;
+	int ret;
+
+	if (!map || !handle)
+		return -EINVAL;
+
+	if (map->free_slot == SLOTMAP_NO_SLOT) {
+		if (map->capacity >= UINT32_MAX / 2)
+			return -ENOMEM;
+		ret = slotmap_grow(map, map->capacity * 2);
+		if (ret < 0)
+			return ret;
+	}
+
+	idx = map->free_slot;
+	slot = &map->slots[idx];
+	map->free_slot = slot->idx;
+
+	/* odd generation marks a used slot, 0 is never used */
+	slot->gen++;
+	slot->idx = map->count;
+	map->dense_slot[map->count] = idx;
+
+	dst = map->data + (size_t)map->count * map->elem_size;
+	if (elem)
+		memcpy(dst, elem, map->elem_size);
+	else
+		memset(dst, 0, map->elem_size);
+	map->count++;
+
+	*handle = slotmap_handle(slot->gen, idx);
+	return 0;
+}
+
+static struct slotmap_slot *slotmap_find(const struct futils_slotmap *map,
+					 uint64_t handle)
+{
+	uint32_t idx = (uint32_t)handle;
+	uint32_t gen = (uint32_t)(handle >> 32);
+
+	if (!map || idx >= map->capacity || map->slots[idx].gen != gen ||
+	    !(gen & 1))
+		return NULL;
+
+	return &map->slots[idx];
+}
+
+int futils_slotmap_remove(struct futils_slotmap *map, uint64_t handle)
+{
+	struct slotmap_slot *slot;
+	uint32_t idx, last;
+
+	slot = slotmap_find(map, handle);
+	if (!slot)
+		return map ? -ENOENT : -EINVAL;
+
+	/* move last element in the hole */
+	idx = slot->idx;
+	last = map->count - 1;
+	if (idx != last) {
+		memcpy(map->data + (size_t)idx * map->elem_size,
+		       map->data + (size_t)last * map->elem_size,
+		       map->elem_size);
+		map->dense_slot[idx] = map->dense_slot[last];
+		map->slots[map->dense_slot[idx]].idx = idx;
+	}
+	map->count--;
+
+	/* even generation, handle becomes stale */
+	slot->gen++;
+	slot->idx = map->free_slot;
+	map->free_slot = (uint32_t)handle;
+	return 0;
+}
+
+int futils_slotmap_clear(struct futils_slotmap *map)
+{
+	uint32_t i;
+
+	if (!map)
+		return -EINVAL;
+
+	while (map->count > 0) {
+		i = map->dense_slot[map->count - 1];
+		futils_slotmap_remove(map,
+				      slotmap_handle(map->slots[i].gen, i));
+	}
+
+	return 0;
+}
+
+void *futils_slotmap_get(const struct futils_slotmap *map, uint64_t handle)
+{
+	const struct slotmap_slot *slot = slotmap_find(map, handle);
+
+	if (!slot)
+		return NULL;
+
+	return map->data + (size_t)slot->idx * map->elem_size;
+}
+
+size_t futils_slotmap_count(const struct futils_slotmap *map)
+{
+	return map ? map->count : 0;
+}
+
+void *futils_slotmap_data(const struct futils_slotmap *map)
+{
+	return map && map->count > 0 ? map->data : NULL;
+}
+
+uint64_t futils_slotmap_handle_at(const struct futils_slotmap *map,
+				  size_t idx)
+{
+	uint32_t slot;
+
+	if (!map || idx >= map->count)
+		return FUTILS_SLOTMAP_INVALID_HANDLE;
+
+	slot = map->dense_slot[idx];
+	return slotmap_handle(map->slots[slot].gen, slot);
+}
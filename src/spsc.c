@@ -0,0 +1,380 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file spsc.c
+ *
+ * @brief single producer single consumer ring
+ *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#define ULOG_TAG futils_spsc
+#include <ulog.h>
+ULOG_DECLARE_TAG(futils_spsc);
+
+#include "futils/fdutils.h"
+#include "futils/spsc.h"
+
+#define SPSC_CACHE_LINE 64
+
+/* variable size records: header, then data, padded to SPSC_ALIGN */
+#define SPSC_ALIGN 8
+#define SPSC_HDR_SIZE sizeof(uint32_t)
+
+/* header of a variable size record telling to go back to ring start */
+#define SPSC_WRAP UINT32_MAX
+
+#define SPSC_LINE_PAD(n) char n[SPSC_CACHE_LINE - 2 * sizeof(size_t)]
+
+struct futils_spsc {
+	/* producer side */
+	size_t tail;			/* next write position */
+	size_t head_cache;		/* last seen consumer position */
+	SPSC_LINE_PAD(pad0);
+
+	/* consumer side */
+	size_t head;			/* next read position */
+	size_t tail_cache;		/* last seen producer position */
+	SPSC_LINE_PAD(pad1);
+
+	/* consumer is waiting for a notification */
+	int parked;
+	char pad2[SPSC_CACHE_LINE - sizeof(int)];
+
+	/* read only after creation */
+	uint8_t *buf;			/* records */
+	size_t size;			/* number of records, or bytes */
+	size_t mask;			/* size - 1 */
+	size_t record_size;		/* fixed record size, 0 if variable */
+	int fds[2];			/* notification fds, -1 if none */
+};
+
+static inline size_t spsc_align(size_t len)
+{
+	return (len + SPSC_ALIGN - 1) & ~(size_t)(SPSC_ALIGN - 1);
+}
+
+static void spsc_notify(struct futils_spsc *spsc)
+{
+	ssize_t ret;
+#ifdef __linux__
+	const uint64_t val = 1;
+#else
+	const uint8_t val = 0x55;
+#endif
+
+	do {
+		ret = write(spsc->fds[1], &val, sizeof(val));
+	} while (ret == -1 && errno == EINTR);
+	if (ret == -1 && errno != EAGAIN)
+		ULOG_ERRNO("write() notify", errno);
+}
+
+static void spsc_drain(struct futils_spsc *spsc)
+{
+	uint8_t val[64];
+	ssize_t ret;
+
+	do {
+		ret = read(spsc->fds[0], val, sizeof(val));
+	} while (ret > 0 || (ret == -1 && errno == EINTR));
+}
+
+static int spsc_init_fds(struct futils_spsc *spsc)
+{
+#ifdef __linux__
+	spsc->fds[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (spsc->fds[0] < 0)
+		return -errno;
+	spsc->fds[1] = spsc->fds[0];
+#else
+	int i;
+
+	if (pipe(spsc->fds) < 0)
+		return -errno;
+
+	for (i = 0; i < 2; i++) {
+		fd_add_flags(spsc->fds[i], O_NONBLOCK);
+		fd_set_close_on_exec(spsc->fds[i]);
+	}
+#endif
+	return 0;
+}
+
+struct futils_spsc *futils_spsc_new(size_t size, size_t record_size,
+				    int flags)
+{
+	struct futils_spsc *spsc;
+	size_t n = 1, bytes;
+	int ret;
+
+	if (size == 0)
+		return NULL;
+
+	while (n < size) {
+		if (n > SIZE_MAX / 2)
+			return NULL;
+		n *= 2;
+	}
+
+	if (record_size == 0) {
+		/* room for at least one aligned header and a wrap marker */
+		if (n < 2 * SPSC_ALIGN)
+			n = 2 * SPSC_ALIGN;
+		bytes = n;
+	} else {
+		if (n > SIZE_MAX / record_size)
+			return NULL;
+		bytes = n * record_size;
+	}
+
+	spsc = calloc(1, sizeof(*spsc));
+	if (!spsc)
+		return NULL;
+	spsc->fds[0] = -1;
+	spsc->fds[1] = -1;
+
+	spsc->buf = malloc(bytes);
+	if (!spsc->buf)
+		goto error;
+
+	if (flags & FUTILS_SPSC_FLAG_NOTIFY) {
+		ret = spsc_init_fds(spsc);
+		if (ret < 0) {
+			ULOG_ERRNO("spsc_init_fds", -ret);
+			goto error;
+		}
+	}
+
+	spsc->size = n;
+	spsc->mask = n - 1;
+	spsc->record_size = record_size;
+	return spsc;
+
+error:
+	free(spsc->buf);
+	free(spsc);
+	return NULL;
+}
+
+void futils_spsc_destroy(struct futils_spsc *spsc)
+{
+	if (!spsc)
+		return;
+
+	if (spsc->fds[0] >= 0)
+		close(spsc->fds[0]);
+	if (spsc->fds[1] >= 0 && spsc->fds[1] != spsc->fds[0])
+		close(spsc->fds[1]);
+	free(spsc->buf);
+	free(spsc);
+}
+
+ssize_t futils_spsc_get_max_size(const struct futils_spsc *spsc)
+{
+	if (!spsc)
+		return -EINVAL;
+
+	if (spsc->record_size != 0)
+		return spsc->record_size;
+
+	/* half of the ring, so that a record always fits in an empty ring
+	 * whatever the wrap position */
+	return spsc->size / 2 - SPSC_HDR_SIZE;
+}
+
+/* get room available for producer, refreshing consumer position only if
+ * cached one does not give enough room */
+static inline size_t spsc_room(struct futils_spsc *spsc, size_t needed)
+{
+	size_t room = spsc->size - (spsc->tail - spsc->head_cache);
+
+	if (room < needed) {
+		spsc->head_cache = __atomic_load_n(&spsc->head,
+						   __ATOMIC_ACQUIRE);
+		room = spsc->size - (spsc->tail - spsc->head_cache);
+	}
+
+	return room;
+}
+
+static inline void spsc_publish(struct futils_spsc *spsc, size_t tail)
+{
+	__atomic_store_n(&spsc->tail, tail, __ATOMIC_RELEASE);
+
+	if (spsc->fds[1] < 0)
+		return;
+
+	/* pairs with the fence of futils_spsc_prepare_wait(): either the
+	 * consumer sees the new tail, or we see it parked */
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&spsc->parked, __ATOMIC_RELAXED) &&
+	    __atomic_exchange_n(&spsc->parked, 0, __ATOMIC_ACQ_REL))
+		spsc_notify(spsc);
+}
+
+int futils_spsc_push(struct futils_spsc *spsc, const void *record, size_t len)
+{
+	size_t tail, off, contig, needed, total;
+	uint32_t hdr;
+
+	if (!spsc || (!record && len > 0))
+		return -EINVAL;
+
+	/* fixed size records */
+	if (spsc->record_size != 0) {
+		if (len != spsc->record_size)
+			return -EINVAL;
+		if (spsc_room(spsc, 1) < 1)
+			return -EAGAIN;
+		memcpy(spsc->buf + (spsc->tail & spsc->mask) * len, record,
+		       len);
+		spsc_publish(spsc, spsc->tail + 1);
+		return 0;
+	}
+
+	/* variable size records */
+	if (len > (size_t)futils_spsc_get_max_size(spsc))
+		return -EMSGSIZE;
+
+	tail = spsc->tail;
+	needed = spsc_align(SPSC_HDR_SIZE + len);
+	off = tail & spsc->mask;
+	contig = spsc->size - off;
+	total = contig < needed ? contig + needed : needed;
+	if (spsc_room(spsc, total) < total)
+		return -EAGAIN;
+
+	/* not enough room before ring end, skip to ring start */
+	if (contig < needed) {
+		hdr = SPSC_WRAP;
+		memcpy(spsc->buf + off, &hdr, sizeof(hdr));
+		tail += contig;
+		off = 0;
+	}
+
+	hdr = (uint32_t)len;
+	memcpy(spsc->buf + off, &hdr, sizeof(hdr));
+	if (len > 0)
+		memcpy(spsc->buf + off + SPSC_HDR_SIZE, record, len);
+
+	/* marker and record are published at once */
+	spsc_publish(spsc, tail + needed);
+	return 0;
+}
+
+/* check if a record is available, refreshing producer position only if
+ * cached one is reached */
+static inline int spsc_available(struct futils_spsc *spsc)
+{
+	if (spsc->head != spsc->tail_cache)
+		return 1;
+
+	spsc->tail_cache = __atomic_load_n(&spsc->tail, __ATOMIC_ACQUIRE);
+	return spsc->head != spsc->tail_cache;
+}
+
+ssize_t futils_spsc_pop(struct futils_spsc *spsc, void *record, size_t len)
+{
+	size_t head, off;
+	uint32_t hdr;
+
+	if (!spsc || !record)
+		return -EINVAL;
+
+	if (!spsc_available(spsc))
+		return -EAGAIN;
+
+	/* fixed size records */
+	if (spsc->record_size != 0) {
+		if (len < spsc->record_size)
+			return -ENOBUFS;
+		memcpy(record, spsc->buf + (spsc->head & spsc->mask) *
+		       spsc->record_size, spsc->record_size);
+		__atomic_store_n(&spsc->head, spsc->head + 1,
+				 __ATOMIC_RELEASE);
+		return spsc->record_size;
+	}
+
+	/* variable size records */
+	head = spsc->head;
+	off = head & spsc->mask;
+	memcpy(&hdr, spsc->buf + off, sizeof(hdr));
+	if (hdr == SPSC_WRAP) {
+		/* the record after the marker was published with it */
+		head += spsc->size - off;
+		off = 0;
+		memcpy(&hdr, spsc->buf, sizeof(hdr));
+	}
+
+	if (hdr > len) {
+		/* skipping the marker is fine, it is the same position */
+		__atomic_store_n(&spsc->head, head, __ATOMIC_RELEASE);
+		return -ENOBUFS;
+	}
+
+	if (hdr > 0)
+		memcpy(record, spsc->buf + off + SPSC_HDR_SIZE, hdr);
+	__atomic_store_n(&spsc->head, head + spsc_align(SPSC_HDR_SIZE + hdr),
+			 __ATOMIC_RELEASE);
+	return hdr;
+}
+
+int futils_spsc_is_empty(struct futils_spsc *spsc)
+{
+	return spsc ? !spsc_available(spsc) : 1;
+}
+
+int futils_spsc_get_fd(const struct futils_spsc *spsc)
+{
+	return spsc ? spsc->fds[0] : -1;
+}
+
+int futils_spsc_prepare_wait(struct futils_spsc *spsc)
+{
+	if (!spsc || spsc->fds[0] < 0)
+		return -EINVAL;
+
+	/* clear notifications of a previous park */
+	spsc_drain(spsc);
+
+	__atomic_store_n(&spsc->parked, 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+	if (spsc_available(spsc)) {
+		__atomic_store_n(&spsc->parked, 0, __ATOMIC_RELAXED);
+		return -EAGAIN;
+	}
+
+	return 0;
+}
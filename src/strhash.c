@@ -0,0 +1,434 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file strhash.c
+ *
+ * @brief hash table with variable length keys
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/strhash.h"
+#include "rh_table.h"
+
+/* minimum table size, must be a power of 2 */
+#define STRHASH_MIN_SIZE 8
+
+/* maximum table size, must be a power of 2 */
+#define STRHASH_MAX_SIZE (UINT32_C(1) << 31)
+
+/* maximum load factor, expressed in eighths */
+#define STRHASH_MAX_LOAD 7
+
+/* size of arena chunks, larger keys get a dedicated chunk */
+#define STRHASH_CHUNK_SIZE 4096
+
+/**
+ * arena chunk, followed by key bytes
+ */
+struct futils_strhash_chunk {
+	struct futils_strhash_chunk *next;	/* next chunk */
+	size_t used;				/* used bytes */
+	size_t size;				/* total bytes */
+};
+
+/**
+ * key looked up in table
+ */
+struct strhash_key {
+	uint32_t hash;		/* key hash value */
+	const void *key;	/* key bytes */
+	size_t len;		/* key length */
+};
+
+/* storage of zero length keys */
+static const uint8_t strhash_empty_key[1];
+
+static uint32_t strhash_hash(const void *key, size_t len)
+{
+	uint64_t h = futils_hash_bytes(key, len, 0);
+
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+static uint32_t strhash_grow_at(uint32_t size)
+{
+	return (uint32_t)(((uint64_t)size * STRHASH_MAX_LOAD) / 8);
+}
+
+static const void *strhash_arena_dup(struct futils_strhash *hash,
+				     const void *key, size_t len)
+{
+	struct futils_strhash_chunk *chunk = hash->arena;
+	uint8_t *p;
+
+	if (!chunk || chunk->size - chunk->used < len) {
+		if (len > STRHASH_CHUNK_SIZE / 4) {
+			/* dedicated chunk, keep filling current one */
+			chunk = malloc(sizeof(*chunk) + len);
+			if (!chunk)
+				return NULL;
+			chunk->used = len;
+			chunk->size = len;
+			if (hash->arena) {
+				chunk->next = hash->arena->next;
+				hash->arena->next = chunk;
+			} else {
+				chunk->next = NULL;
+				hash->arena = chunk;
+			}
+			p = (uint8_t *)(chunk + 1);
+			memcpy(p, key, len);
+			return p;
+		}
+
+		chunk = malloc(sizeof(*chunk) + STRHASH_CHUNK_SIZE);
+		if (!chunk)
+			return NULL;
+		chunk->used = 0;
+		chunk->size = STRHASH_CHUNK_SIZE;
+		chunk->next = hash->arena;
+		hash->arena = chunk;
+	}
+
+	p = (uint8_t *)(chunk + 1) + chunk->used;
+	chunk->used += len;
+	memcpy(p, key, len);
+	return p;
+}
+
+static const void *strhash_key_dup(struct futils_strhash *hash,
+				   const void *key, size_t len)
+{
+	void *p;
+
+	if (len == 0)
+		return strhash_empty_key;
+
+	if (hash->flags & FUTILS_STRHASH_ARENA)
+		return strhash_arena_dup(hash, key, len);
+
+	p = malloc(len);
+	if (!p)
+		return NULL;
+	memcpy(p, key, len);
+	return p;
+}
+
+static void strhash_key_free(struct futils_strhash *hash,
+			     struct futils_strhash_slot *slot)
+{
+	/* arena keys are released all at once */
+	if (slot->len != 0 && !(hash->flags & FUTILS_STRHASH_ARENA))
+		free((void *)slot->key);
+}
+
+static int strhash_alloc(struct futils_strhash *hash, size_t size)
+{
+	struct futils_strhash_slot *slots;
+
+	slots = calloc(size, sizeof(*slots));
+	if (!slots)
+		return -ENOMEM;
+
+	hash->slots = slots;
+	hash->mask = (uint32_t)(size - 1);
+	hash->grow_at = strhash_grow_at((uint32_t)size);
+	return 0;
+}
+
+static uint32_t strhash_get_dib(const void *slot)
+{
+	return ((const struct futils_strhash_slot *)slot)->dib;
+}
+
+static void strhash_set_dib(void *slot, uint32_t dib)
+{
+	((struct futils_strhash_slot *)slot)->dib = dib;
+}
+
+static uint32_t strhash_get_hash(const void *slot)
+{
+	return ((const struct futils_strhash_slot *)slot)->hash;
+}
+
+static int strhash_match(const void *_slot, const void *_key)
+{
+	const struct futils_strhash_slot *slot = _slot;
+	const struct strhash_key *key = _key;
+
+	/* only compare key bytes when hash values match */
+	return slot->hash == key->hash && slot->len == key->len &&
+	       (key->len == 0 || memcmp(slot->key, key->key, key->len) == 0);
+}
+
+static const struct rh_table_ops strhash_ops = {
+	.slot_size = sizeof(struct futils_strhash_slot),
+	.get_dib = &strhash_get_dib,
+	.set_dib = &strhash_set_dib,
+	.get_hash = &strhash_get_hash,
+	.match = &strhash_match,
+};
+
+static void strhash_place(struct futils_strhash *hash,
+			  const struct futils_strhash_slot *slot)
+{
+	rh_table_place(&strhash_ops, hash->slots, hash->mask, slot);
+	hash->count++;
+}
+
+static int strhash_grow(struct futils_strhash *hash)
+{
+	struct futils_strhash_slot *old = hash->slots;
+	size_t old_size = (size_t)hash->mask + 1;
+	int ret;
+
+	if (old_size >= STRHASH_MAX_SIZE)
+		return -ENOMEM;
+
+	ret = strhash_alloc(hash, old_size * 2);
+	if (ret < 0)
+		return ret;
+
+	/* re-insert all entries in the new table using stored hash values */
+	rh_table_rehash(&strhash_ops, hash->slots, hash->mask, old, old_size);
+
+	free(old);
+	return 0;
+}
+
+static int strhash_find(const struct futils_strhash *hash, uint32_t h,
+			const void *key, size_t len, uint32_t *_idx)
+{
+	struct strhash_key k = {
+		.hash = h,
+		.key = key,
+		.len = len,
+	};
+
+	return rh_table_find(&strhash_ops, hash->slots, hash->mask, h, &k,
+			     _idx);
+}
+
+int futils_strhash_init(struct futils_strhash *hash, size_t size, int flags,
+			void (*hfree)(void *))
+{
+	size_t tab_size;
+	int ret;
+
+	if (!hash)
+		return -EINVAL;
+
+	/* reset hash memory */
+	memset(hash, 0, sizeof(*hash));
+
+	/* get upper power of 2 keeping the load factor under its maximum */
+	if (size > STRHASH_MAX_SIZE / 8 * STRHASH_MAX_LOAD)
+		return -EINVAL;
+	tab_size = STRHASH_MIN_SIZE;
+	while (strhash_grow_at(tab_size) < size)
+		tab_size *= 2;
+
+	ret = strhash_alloc(hash, tab_size);
+	if (ret < 0)
+		return ret;
+
+	hash->flags = flags;
+	/* set allocator free callback */
+	hash->hfree = hfree;
+	return 0;
+}
+
+int futils_strhash_remove_all(struct futils_strhash *hash)
+{
+	struct futils_strhash_chunk *chunk, *next;
+	size_t i;
+
+	if (!hash || !hash->slots)
+		return -EINVAL;
+
+	for (i = 0; i <= hash->mask; i++) {
+		if (hash->slots[i].dib == 0)
+			continue;
+		if (hash->hfree && !hash->slots[i].is_const)
+			hash->hfree(hash->slots[i].data);
+		strhash_key_free(hash, &hash->slots[i]);
+	}
+
+	for (chunk = hash->arena; chunk; chunk = next) {
+		next = chunk->next;
+		free(chunk);
+	}
+	hash->arena = NULL;
+
+	memset(hash->slots, 0, ((size_t)hash->mask + 1) * sizeof(*hash->slots));
+	hash->count = 0;
+	return 0;
+}
+
+int futils_strhash_destroy(struct futils_strhash *hash)
+{
+	if (!hash)
+		return -EINVAL;
+
+	if (hash->slots)
+		futils_strhash_remove_all(hash);
+	free(hash->slots);
+	memset(hash, 0, sizeof(*hash));
+	return 0;
+}
+
+static int futils_strhash_insert_slot(struct futils_strhash *hash,
+				      const void *key, size_t len,
+				      struct futils_strhash_slot slot)
+{
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots || (!key && len > 0))
+		return -EINVAL;
+
+	/* compare keys to find if another entry with same key has been
+	 * already added */
+	slot.hash = strhash_hash(key, len);
+	if (strhash_find(hash, slot.hash, key, len, &idx) == 0)
+		return -EEXIST;
+
+	if (hash->count >= hash->grow_at) {
+		ret = strhash_grow(hash);
+		if (ret < 0)
+			return ret;
+	}
+
+	slot.key = strhash_key_dup(hash, key, len);
+	if (!slot.key)
+		return -ENOMEM;
+	slot.len = len;
+
+	strhash_place(hash, &slot);
+	return 0;
+}
+
+int futils_strhash_insert(struct futils_strhash *hash, const void *key,
+			  size_t len, void *data)
+{
+	struct futils_strhash_slot slot;
+
+	memset(&slot, 0, sizeof(slot));
+	slot.is_const = 0;
+	slot.data = data;
+
+	return futils_strhash_insert_slot(hash, key, len, slot);
+}
+
+int futils_strhash_insert_const(struct futils_strhash *hash, const void *key,
+				size_t len, const void *data)
+{
+	struct futils_strhash_slot slot;
+
+	memset(&slot, 0, sizeof(slot));
+	slot.is_const = 1;
+	slot.const_data = data;
+
+	return futils_strhash_insert_slot(hash, key, len, slot);
+}
+
+static int futils_strhash_lookup_slot(const struct futils_strhash *hash,
+				      const void *key, size_t len,
+				      const struct futils_strhash_slot **slot)
+{
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots || (!key && len > 0))
+		return -EINVAL;
+
+	ret = strhash_find(hash, strhash_hash(key, len), key, len, &idx);
+	if (ret < 0)
+		return ret;
+
+	*slot = &hash->slots[idx];
+	return 0;
+}
+
+int futils_strhash_lookup(const struct futils_strhash *hash, const void *key,
+			  size_t len, void **data)
+{
+	const struct futils_strhash_slot *slot;
+	int ret;
+
+	ret = futils_strhash_lookup_slot(hash, key, len, &slot);
+	if (ret < 0)
+		return ret;
+
+	if (slot->is_const)
+		return -EPERM;
+
+	if (data)
+		*data = slot->data;
+
+	return 0;
+}
+
+int futils_strhash_lookup_const(const struct futils_strhash *hash,
+				const void *key, size_t len,
+				const void **data)
+{
+	const struct futils_strhash_slot *slot;
+	int ret;
+
+	ret = futils_strhash_lookup_slot(hash, key, len, &slot);
+	if (ret < 0)
+		return ret;
+
+	if (data)
+		*data = slot->const_data;
+
+	return 0;
+}
+
+int futils_strhash_remove(struct futils_strhash *hash, const void *key,
+			  size_t len)
+{
+	struct futils_strhash_slot *slot;
+	uint32_t idx;
+	int ret;
+
+	if (!hash || !hash->slots || (!key && len > 0))
+		return -EINVAL;
+
+	ret = strhash_find(hash, strhash_hash(key, len), key, len, &idx);
+	if (ret < 0)
+		return ret;
+
+	slot = &hash->slots[idx];
+	if (hash->hfree && !slot->is_const)
+		hash->hfree(slot->data);
+	strhash_key_free(hash, slot);
+
+	rh_table_remove_at(&strhash_ops, hash->slots, hash->mask, idx);
+	hash->count--;
+	return 0;
+}
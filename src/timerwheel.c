@@ -0,0 +1,350 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file timerwheel.c
+ *
+ * @brief hierarchical timer wheel
+ *
+ *****************************************************************************/
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include "futils/timetools.h"
+#include "futils/timerwheel.h"
+
+/* number of tick bits per level */
+#define TIMERWHEEL_BITS 6
+
+#define TIMERWHEEL_MASK (FUTILS_TIMERWHEEL_SLOTS - 1)
+
+static int timerwheel_get_now_ms(uint64_t *now_ms)
+{
+	struct timespec ts;
+	int ret;
+
+	ret = time_get_monotonic(&ts);
+	if (ret < 0)
+		return ret;
+
+	return time_timespec_to_ms(&ts, now_ms);
+}
+
+/* first tick of a slot, the current time being in the previous slots */
+static uint64_t timerwheel_slot_start(uint64_t now, uint32_t level,
+				      uint32_t slot)
+{
+	uint32_t shift = level * TIMERWHEEL_BITS;
+	uint64_t high = 0;
+
+	if (shift + TIMERWHEEL_BITS < 64)
+		high = (now >> (shift + TIMERWHEEL_BITS)) <<
+		       (shift + TIMERWHEEL_BITS);
+
+	return high | ((uint64_t)slot << shift);
+}
+
+/**
+ * put a timer in the level of the highest tick bits differing from current
+ * time: it is then in a slot after the current one of this level, and will
+ * be moved down when time reaches the start of this slot.
+ */
+static void timerwheel_place(struct futils_timerwheel *wheel,
+			     struct futils_timer *timer)
+{
+	uint64_t diff = timer->expire ^ wheel->now;
+	uint32_t level = 0;
+
+	if (diff != 0)
+		level = (63 - __builtin_clzll(diff)) / TIMERWHEEL_BITS;
+
+	timer->level = (uint8_t)level;
+	timer->slot = (uint8_t)((timer->expire >> (level * TIMERWHEEL_BITS)) &
+				TIMERWHEEL_MASK);
+	list_add_before(&wheel->slots[level][timer->slot], &timer->node);
+	wheel->occupied[level] |= UINT64_C(1) << timer->slot;
+}
+
+static void timerwheel_unlink(struct futils_timerwheel *wheel,
+			      struct futils_timer *timer)
+{
+	struct list_node *slot = &wheel->slots[timer->level][timer->slot];
+
+	list_del(&timer->node);
+	if (list_is_empty(slot))
+		wheel->occupied[timer->level] &= ~(UINT64_C(1) << timer->slot);
+}
+
+/* tick of next slot to process, UINT64_MAX if wheel is empty */
+static uint64_t timerwheel_next_event(const struct futils_timerwheel *wheel)
+{
+	uint64_t next = UINT64_MAX;
+	uint64_t mask, start;
+	uint32_t level, cur;
+
+	for (level = 0; level < FUTILS_TIMERWHEEL_LEVELS; level++) {
+		if (!wheel->occupied[level])
+			continue;
+
+		/* occupied slots are always after the current one */
+		cur = (wheel->now >> (level * TIMERWHEEL_BITS)) &
+		      TIMERWHEEL_MASK;
+		mask = cur == TIMERWHEEL_MASK ? 0 :
+		       wheel->occupied[level] & (~UINT64_C(0) << (cur + 1));
+		if (!mask)
+			continue;
+
+		start = timerwheel_slot_start(wheel->now, level,
+					      __builtin_ctzll(mask));
+		if (start < next)
+			next = start;
+	}
+
+	return next;
+}
+
+/* move timers of a higher level slot down to lower levels */
+static void timerwheel_cascade(struct futils_timerwheel *wheel,
+			       uint32_t level, uint32_t slot)
+{
+	struct list_node *head = &wheel->slots[level][slot];
+	struct futils_timer *timer;
+
+	/* time is at the start of the slot, so timers go to lower levels */
+	while (!list_is_empty(head)) {
+		timer = FUTILS_CONTAINER_OF(head->next, struct futils_timer,
+					    node);
+		list_del(&timer->node);
+		timerwheel_place(wheel, timer);
+	}
+
+	wheel->occupied[level] &= ~(UINT64_C(1) << slot);
+}
+
+static int timerwheel_expire(struct futils_timerwheel *wheel)
+{
+	uint32_t slot = wheel->now & TIMERWHEEL_MASK;
+	struct list_node *head = &wheel->slots[0][slot];
+	struct futils_timer *timer;
+	int count = 0;
+
+	/* callbacks may arm or cancel any timer, including in this slot */
+	while (!list_is_empty(head)) {
+		timer = FUTILS_CONTAINER_OF(head->next, struct futils_timer,
+					    node);
+		timerwheel_unlink(wheel, timer);
+		wheel->count--;
+		count++;
+		timer->cb(timer, timer->userdata);
+	}
+
+	return count;
+}
+
+void futils_timer_init(struct futils_timer *timer, futils_timer_cb_t cb,
+		       void *userdata)
+{
+	if (!timer)
+		return;
+
+	memset(timer, 0, sizeof(*timer));
+	list_node_unref(&timer->node);
+	timer->cb = cb;
+	timer->userdata = userdata;
+}
+
+int futils_timer_is_armed(const struct futils_timer *timer)
+{
+	if (!timer)
+		return 0;
+
+	return list_node_is_ref((struct list_node *)&timer->node);
+}
+
+int futils_timerwheel_init(struct futils_timerwheel *wheel, uint32_t tick_ms)
+{
+	uint64_t now_ms;
+	uint32_t level, slot;
+	int ret;
+
+	if (!wheel || tick_ms == 0)
+		return -EINVAL;
+
+	ret = timerwheel_get_now_ms(&now_ms);
+	if (ret < 0)
+		return ret;
+
+	memset(wheel, 0, sizeof(*wheel));
+	wheel->tick_ms = tick_ms;
+	wheel->now = now_ms / tick_ms;
+	for (level = 0; level < FUTILS_TIMERWHEEL_LEVELS; level++) {
+		for (slot = 0; slot < FUTILS_TIMERWHEEL_SLOTS; slot++)
+			list_init(&wheel->slots[level][slot]);
+	}
+
+	return 0;
+}
+
+int futils_timerwheel_arm_at(struct futils_timerwheel *wheel,
+			     struct futils_timer *timer, uint64_t expire_ms)
+{
+	uint64_t expire;
+
+	if (!wheel || !timer || !timer->cb)
+		return -EINVAL;
+
+	futils_timerwheel_cancel(wheel, timer);
+
+	/* round up, never expire early */
+	expire = expire_ms / wheel->tick_ms;
+	if (expire_ms % wheel->tick_ms)
+		expire++;
+
+	/* current tick has already been processed */
+	if (expire <= wheel->now)
+		expire = wheel->now + 1;
+
+	timer->expire = expire;
+	timerwheel_place(wheel, timer);
+	wheel->count++;
+	return 0;
+}
+
+int futils_timerwheel_arm(struct futils_timerwheel *wheel,
+			  struct futils_timer *timer, uint32_t timeout_ms)
+{
+	uint64_t now_ms;
+	int ret;
+
+	if (!wheel || !timer)
+		return -EINVAL;
+
+	ret = timerwheel_get_now_ms(&now_ms);
+	if (ret < 0)
+		return ret;
+
+	return futils_timerwheel_arm_at(wheel, timer, now_ms + timeout_ms);
+}
+
+int futils_timerwheel_cancel(struct futils_timerwheel *wheel,
+			     struct futils_timer *timer)
+{
+	if (!wheel || !timer)
+		return -EINVAL;
+
+	if (!futils_timer_is_armed(timer))
+		return 0;
+
+	timerwheel_unlink(wheel, timer);
+	wheel->count--;
+	return 0;
+}
+
+int futils_timerwheel_advance_to(struct futils_timerwheel *wheel,
+				 uint64_t now_ms)
+{
+	uint64_t target, next, low_mask;
+	uint32_t level, slot;
+	int count = 0;
+
+	if (!wheel)
+		return -EINVAL;
+
+	target = now_ms / wheel->tick_ms;
+
+	/* jump from slot to slot until target time */
+	while ((next = timerwheel_next_event(wheel)) <= target) {
+		wheel->now = next;
+
+		/* move down timers of slots starting now, higher first */
+		for (level = FUTILS_TIMERWHEEL_LEVELS - 1; level > 0; level--) {
+			low_mask = (UINT64_C(1) << (level * TIMERWHEEL_BITS)) -
+				   1;
+			if (wheel->now & low_mask)
+				continue;
+			slot = (wheel->now >> (level * TIMERWHEEL_BITS)) &
+			       TIMERWHEEL_MASK;
+			if (wheel->occupied[level] & (UINT64_C(1) << slot))
+				timerwheel_cascade(wheel, level, slot);
+		}
+
+		count += timerwheel_expire(wheel);
+	}
+
+	if (target > wheel->now)
+		wheel->now = target;
+
+	return count;
+}
+
+int futils_timerwheel_advance(struct futils_timerwheel *wheel)
+{
+	uint64_t now_ms;
+	int ret;
+
+	if (!wheel)
+		return -EINVAL;
+
+	ret = timerwheel_get_now_ms(&now_ms);
+	if (ret < 0)
+		return ret;
+
+	return futils_timerwheel_advance_to(wheel, now_ms);
+}
+
+int futils_timerwheel_next_expiry(const struct futils_timerwheel *wheel,
+				  uint64_t *expire_ms)
+{
+	uint64_t next;
+
+	if (!wheel || !expire_ms)
+		return -EINVAL;
+
+	next = timerwheel_next_event(wheel);
+	if (next == UINT64_MAX)
+		return -ENOENT;
+
+	*expire_ms = next * wheel->tick_ms;
+	return 0;
+}
+
+int futils_timerwheel_get_timeout(const struct futils_timerwheel *wheel)
+{
+	uint64_t expire_ms, now_ms;
+	int ret;
+
+	ret = futils_timerwheel_next_expiry(wheel, &expire_ms);
+	if (ret < 0)
+		return -1;
+
+	ret = timerwheel_get_now_ms(&now_ms);
+	if (ret < 0 || expire_ms <= now_ms)
+		return 0;
+
+	if (expire_ms - now_ms > INT_MAX)
+		return INT_MAX;
+
+	return (int)(expire_ms - now_ms);
+}
@@ -0,0 +1,253 @@
+/******************************************************************************
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file vec.c
+ *
+ * @brief growable array
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "futils/vec.h"
+
+/* minimum allocated capacity */
+#define VEC_MIN_SIZE 8
+
+static inline uint8_t *vec_elem(const struct futils_vec *vec, size_t idx)
+{
+	return (uint8_t *)vec->data + idx * vec->elem_size;
+}
+
+static inline int vec_is_inline(const struct futils_vec *vec)
+{
+	return vec->inline_buf && vec->data == vec->inline_buf;
+}
+
+/* move elements to a buffer of exactly capacity elements */
+static int vec_realloc(struct futils_vec *vec, size_t capacity)
+{
+	void *data;
+
+	if (capacity > SIZE_MAX / vec->elem_size)
+		return -ENOMEM;
+
+	if (vec_is_inline(vec) || !vec->data) {
+		data = malloc(capacity * vec->elem_size);
+		if (!data)
+			return -ENOMEM;
+		if (vec->count > 0)
+			memcpy(data, vec->data, vec->count * vec->elem_size);
+	} else {
+		data = realloc(vec->data, capacity * vec->elem_size);
+		if (!data)
+			return -ENOMEM;
+	}
+
+	vec->data = data;
+	vec->capacity = capacity;
+	return 0;
+}
+
+static int vec_grow(struct futils_vec *vec, size_t count)
+{
+	size_t capacity;
+
+	if (count <= vec->capacity)
+		return 0;
+
+	capacity = vec->capacity < VEC_MIN_SIZE ? VEC_MIN_SIZE : vec->capacity;
+	while (capacity < count) {
+		if (capacity > SIZE_MAX / 2)
+			return -ENOMEM;
+		capacity *= 2;
+	}
+
+	return vec_realloc(vec, capacity);
+}
+
+int futils_vec_init(struct futils_vec *vec, size_t elem_size, void *buf,
+		    size_t buf_count)
+{
+	if (!vec || elem_size == 0 || (!buf && buf_count > 0))
+		return -EINVAL;
+
+	memset(vec, 0, sizeof(*vec));
+	vec->elem_size = elem_size;
+	if (buf && buf_count > 0) {
+		vec->inline_buf = buf;
+		vec->inline_capacity = buf_count;
+		vec->data = buf;
+		vec->capacity = buf_count;
+	}
+
+	return 0;
+}
+
+int futils_vec_destroy(struct futils_vec *vec)
+{
+	if (!vec)
+		return -EINVAL;
+
+	if (!vec_is_inline(vec))
+		free(vec->data);
+	memset(vec, 0, sizeof(*vec));
+	return 0;
+}
+
+int futils_vec_clear(struct futils_vec *vec)
+{
+	if (!vec)
+		return -EINVAL;
+
+	vec->count = 0;
+	return 0;
+}
+
+int futils_vec_reserve(struct futils_vec *vec, size_t count)
+{
+	if (!vec)
+		return -EINVAL;
+
+	if (count <= vec->capacity)
+		return 0;
+
+	return vec_realloc(vec, count);
+}
+
+int futils_vec_shrink(struct futils_vec *vec)
+{
+	if (!vec)
+		return -EINVAL;
+
+	if (vec_is_inline(vec) || vec->count == vec->capacity)
+		return 0;
+
+	/* back to caller buffer */
+	if (vec->inline_buf && vec->count <= vec->inline_capacity) {
+		if (vec->count > 0)
+			memcpy(vec->inline_buf, vec->data,
+			       vec->count * vec->elem_size);
+		free(vec->data);
+		vec->data = vec->inline_buf;
+		vec->capacity = vec->inline_capacity;
+		return 0;
+	}
+
+	if (vec->count == 0) {
+		free(vec->data);
+		vec->data = NULL;
+		vec->capacity = 0;
+		return 0;
+	}
+
+	return vec_realloc(vec, vec->count);
+}
+
+int futils_vec_insert(struct futils_vec *vec, size_t idx, const void *elem)
+{
+	const uint8_t *src = elem;
+	const uint8_t *data;
+	size_t off = 0;
+	int inside;
+	int ret;
+
+	if (!vec || idx > vec->count)
+		return -EINVAL;
+
+	/* elem may be an element of the vector itself: keep its offset, as
+	 * growing can move the storage and inserting shifts elements */
+	data = vec->data;
+	inside = src && data && src >= data &&
+		 src < data + vec->count * vec->elem_size;
+	if (inside)
+		off = src - data;
+
+	ret = vec_grow(vec, vec->count + 1);
+	if (ret < 0)
+		return ret;
+
+	if (idx < vec->count)
+		memmove(vec_elem(vec, idx + 1), vec_elem(vec, idx),
+			(vec->count - idx) * vec->elem_size);
+
+	if (inside) {
+		if (off >= idx * vec->elem_size)
+			off += vec->elem_size;
+		src = (const uint8_t *)vec->data + off;
+	}
+
+	if (src)
+		memcpy(vec_elem(vec, idx), src, vec->elem_size);
+	else
+		memset(vec_elem(vec, idx), 0, vec->elem_size);
+	vec->count++;
+	return 0;
+}
+
+int futils_vec_push(struct futils_vec *vec, const void *elem)
+{
+	if (!vec)
+		return -EINVAL;
+
+	return futils_vec_insert(vec, vec->count, elem);
+}
+
+int futils_vec_pop(struct futils_vec *vec, void *elem)
+{
+	if (!vec)
+		return -EINVAL;
+
+	if (vec->count == 0)
+		return -ENOENT;
+
+	vec->count--;
+	if (elem)
+		memcpy(elem, vec_elem(vec, vec->count), vec->elem_size);
+	return 0;
+}
+
+int futils_vec_erase(struct futils_vec *vec, size_t idx)
+{
+	if (!vec || idx >= vec->count)
+		return -EINVAL;
+
+	vec->count--;
+	if (idx < vec->count)
+		memmove(vec_elem(vec, idx), vec_elem(vec, idx + 1),
+			(vec->count - idx) * vec->elem_size);
+	return 0;
+}
+
+int futils_vec_swap_remove(struct futils_vec *vec, size_t idx)
+{
+	if (!vec || idx >= vec->count)
+		return -EINVAL;
+
+	vec->count--;
+	if (idx < vec->count)
+		memcpy(vec_elem(vec, idx), vec_elem(vec, vec->count),
+		       vec->elem_size);
+	return 0;
+}
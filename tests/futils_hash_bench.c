@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_hash_bench.c
+ *
+ * @brief struct hash benchmark
+ *
+ */
+
+#include "futils/hash.h"
+#include "futils/timetools.h"
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* minimum number of operations measured per test */
+#define MIN_OPS 1000000
+
+/* number of consecutive keys in a cluster */
+#define CLUSTER_LEN 16
+
+/* distance between the first keys of two clusters */
+#define CLUSTER_STRIDE 4096
+
+enum key_dist {
+	KEY_SEQUENTIAL,
+	KEY_RANDOM,
+	KEY_CLUSTERED,
+};
+
+static const char *const key_dist_str[] = {
+	[KEY_SEQUENTIAL] = "sequential",
+	[KEY_RANDOM] = "random",
+	[KEY_CLUSTERED] = "clustered",
+};
+
+/* table load factors in percent of table size */
+static const uint32_t loads[] = {50, 100, 200};
+
+static const size_t default_counts[] = {1000, 100000, 1000000};
+
+struct result {
+	uint64_t insert_ns;
+	uint64_t hit_ns;
+	uint64_t miss_ns;
+	uint64_t remove_ns;
+	uint64_t iter_ns;
+	uint64_t ops;
+};
+
+/* codecheck_ignore[VOLATILE] */
+static volatile uintptr_t sink;
+
+/* i-th key of a distribution, keys are distinct */
+static uint32_t make_key(enum key_dist dist, uint32_t i)
+{
+	switch (dist) {
+	case KEY_RANDOM:
+		/* bijective mix, so no duplicate key */
+		return futils_hash_u32(i);
+	case KEY_CLUSTERED:
+		return (i / CLUSTER_LEN) * CLUSTER_STRIDE + i % CLUSTER_LEN;
+	case KEY_SEQUENTIAL:
+	default:
+		return i;
+	}
+}
+
+/* number of distinct keys make_key() can generate for a distribution */
+static uint64_t key_space(enum key_dist dist)
+{
+	switch (dist) {
+	case KEY_CLUSTERED:
+		return (UINT64_C(1) << 32) / CLUSTER_STRIDE * CLUSTER_LEN;
+	case KEY_RANDOM:
+	case KEY_SEQUENTIAL:
+	default:
+		return UINT64_C(1) << 32;
+	}
+}
+
+static uint64_t elapsed_ns(const struct timespec *start)
+{
+	struct timespec diff;
+	uint64_t ns = 0;
+
+	time_timespec_diff_now(start, &diff);
+	time_timespec_to_ns(&diff, &ns);
+	return ns;
+}
+
+static int run_round(const uint32_t *keys, const uint32_t *misses,
+		     size_t count, uint32_t load, struct result *res,
+		     struct futils_hash_stats *stats)
+{
+	struct hash hash;
+	struct hash_entry *entry;
+	struct timespec start;
+	uintptr_t sum = 0;
+	size_t found = 0;
+	void *data;
+	size_t i;
+	int ret;
+
+	ret = futils_hash_init(&hash, count * 100 / load, NULL);
+	if (ret < 0)
+		return ret;
+
+	time_get_monotonic(&start);
+	for (i = 0; i < count; i++) {
+		ret = futils_hash_insert(&hash, keys[i], (void *)(uintptr_t)i);
+		if (ret < 0)
+			goto out;
+	}
+	res->insert_ns += elapsed_ns(&start);
+
+	time_get_monotonic(&start);
+	for (i = 0; i < count; i++) {
+		if (futils_hash_lookup(&hash, keys[i], &data) == 0)
+			sum += (uintptr_t)data;
+	}
+	res->hit_ns += elapsed_ns(&start);
+
+	time_get_monotonic(&start);
+	for (i = 0; i < count; i++) {
+		if (futils_hash_lookup(&hash, misses[i], &data) == 0)
+			found++;
+	}
+	res->miss_ns += elapsed_ns(&start);
+
+	/* a miss key equal to an inserted key would skew the results */
+	if (found > 0) {
+		ret = -EEXIST;
+		goto out;
+	}
+
+	time_get_monotonic(&start);
+	list_walk_entry_forward(&hash.entries, entry, node)
+		sum += entry->key;
+	res->iter_ns += elapsed_ns(&start);
+
+	futils_hash_get_stats(&hash, stats);
+
+	time_get_monotonic(&start);
+	for (i = 0; i < count; i++)
+		futils_hash_remove(&hash, keys[i]);
+	res->remove_ns += elapsed_ns(&start);
+
+	res->ops += count;
+	sink = sum;
+
+out:
+	futils_hash_destroy(&hash);
+	return ret;
+}
+
+static int run(size_t count, uint32_t load, enum key_dist dist)
+{
+	struct futils_hash_stats stats;
+	struct result res;
+	uint32_t *keys, *misses;
+	size_t i, rounds;
+	double bytes;
+	int ret = 0;
+
+	keys = calloc(count, sizeof(*keys));
+	misses = calloc(count, sizeof(*misses));
+	if (!keys || !misses) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	/* misses are the keys following the inserted ones */
+	for (i = 0; i < count; i++) {
+		keys[i] = make_key(dist, (uint32_t)i);
+		misses[i] = make_key(dist, (uint32_t)(i + count));
+	}
+
+	memset(&res, 0, sizeof(res));
+	rounds = (MIN_OPS + count - 1) / count;
+	for (i = 0; i < rounds; i++) {
+		ret = run_round(keys, misses, count, load, &res, &stats);
+		if (ret < 0)
+			goto out;
+	}
+
+	/* bucket pointers and entries, allocator overhead not included */
+	bytes = (double)stats.size * sizeof(struct hash_entry *) +
+		(double)count * sizeof(struct hash_entry);
+
+	printf("%8zu %5" PRIu32 "%% %-10s "
+	       "%8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %5" PRIu32 "\n",
+	       count, load, key_dist_str[dist],
+	       (double)res.insert_ns / res.ops,
+	       (double)res.hit_ns / res.ops,
+	       (double)res.miss_ns / res.ops,
+	       (double)res.remove_ns / res.ops,
+	       (double)res.iter_ns / res.ops,
+	       bytes / count, stats.max_chain);
+
+out:
+	free(keys);
+	free(misses);
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t counts[16];
+	size_t ncounts, c, l;
+	unsigned long val;
+	char *end;
+	uint64_t max_count;
+	int d, i, ret;
+
+	if (argc > 1 + (int)(sizeof(counts) / sizeof(counts[0]))) {
+		fprintf(stderr, "Usage: %s [entries...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	/* inserted and miss keys must all be distinct, for every
+	 * distribution */
+	max_count = UINT64_MAX;
+	for (d = KEY_SEQUENTIAL; d <= KEY_CLUSTERED; d++) {
+		if (key_space((enum key_dist)d) / 2 < max_count)
+			max_count = key_space((enum key_dist)d) / 2;
+	}
+
+	ncounts = 0;
+	for (i = 1; i < argc; i++) {
+		errno = 0;
+		val = strtoul(argv[i], &end, 0);
+		if (errno != 0 || end == argv[i] || *end != '\0' ||
+		    val == 0 || val > max_count) {
+			fprintf(stderr, "%s: '%s': invalid number of entries, "
+				"must be in [1, %" PRIu64 "]\n",
+				argv[0], argv[i], max_count);
+			return EXIT_FAILURE;
+		}
+		counts[ncounts++] = val;
+	}
+
+	if (ncounts == 0) {
+		ncounts = sizeof(default_counts) / sizeof(default_counts[0]);
+		memcpy(counts, default_counts, sizeof(default_counts));
+	}
+
+	printf("%8s %6s %-10s %8s %8s %8s %8s %8s %8s %5s\n",
+	       "entries", "load", "keys", "insert", "hit", "miss", "remove",
+	       "iter", "B/entry", "chain");
+	printf("%45s (ns/op)\n", "");
+
+	for (c = 0; c < ncounts; c++) {
+		for (l = 0; l < sizeof(loads) / sizeof(loads[0]); l++) {
+			for (d = KEY_SEQUENTIAL; d <= KEY_CLUSTERED; d++) {
+				ret = run(counts[c], loads[l],
+					  (enum key_dist)d);
+				if (ret < 0) {
+					fprintf(stderr, "%s: test failed: %d (%s)\n",
+						argv[0], -ret, strerror(-ret));
+					return EXIT_FAILURE;
+				}
+			}
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
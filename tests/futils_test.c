@@ -33,17 +33,34 @@
 #include "futils/futils.h"
 #include "stdlib.h"
 
+extern CU_TestInfo s_bloom_tests[];
+extern CU_TestInfo s_deque_tests[];
 extern CU_TestInfo s_mbox_tests[];
+extern CU_TestInfo s_mpmc_tests[];
 extern CU_TestInfo s_dynmbox_tests[];
+extern CU_TestInfo s_flathash_tests[];
+extern CU_TestInfo s_hash_tests[];
+extern CU_TestInfo s_heap_tests[];
 extern CU_TestInfo s_systimetools_tests[];
 extern CU_TestInfo s_list_tests[];
+extern CU_TestInfo s_lru_tests[];
+extern CU_TestInfo s_phash_tests[];
 extern CU_TestInfo s_random_tests[];
+extern CU_TestInfo s_rbtree_tests[];
+extern CU_TestInfo s_slotmap_tests[];
+extern CU_TestInfo s_strhash_tests[];
 extern CU_TestInfo s_varint_tests[];
+extern CU_TestInfo s_vec_tests[];
 extern CU_TestInfo s_timetools_tests[];
+extern CU_TestInfo s_timerwheel_tests[];
 extern CU_TestInfo s_safew_tests[];
+extern CU_TestInfo s_chash_tests[];
+extern CU_TestInfo s_mpscq_tests[];
+extern CU_TestInfo s_spsc_tests[];
 extern CU_TestInfo s_string_tests[];
 extern CU_TestInfo s_fs_cpp_tests[];
 extern CU_TestInfo s_string_cpp_tests[];
+extern CU_TestInfo s_hashmap_cpp_tests[];
 
 static void test_bound(void)
 {
@@ -77,12 +94,48 @@ static CU_SuiteInfo s_suites[] = {
 		.pCleanupFunc = NULL,
 		.pTests = s_mbox_tests
 	},
+	{
+		.pName = (char *)"mpmc",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_mpmc_tests
+	},
+	{
+		.pName = (char *)"bloom",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_bloom_tests
+	},
+	{
+		.pName = (char *)"deque",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_deque_tests
+	},
 	{
 		.pName = (char *)"dynmbox",
 		.pInitFunc = NULL,
 		.pCleanupFunc = NULL,
 		.pTests = s_dynmbox_tests
 	},
+	{
+		.pName = (char *)"flathash",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_flathash_tests
+	},
+	{
+		.pName = (char *)"hash",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_hash_tests
+	},
+	{
+		.pName = (char *)"heap",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_heap_tests
+	},
 	{
 		.pName = (char *)"systimetools",
 		.pInitFunc = NULL,
@@ -95,24 +148,66 @@ static CU_SuiteInfo s_suites[] = {
 		.pCleanupFunc = NULL,
 		.pTests = s_list_tests
 	},
+	{
+		.pName = (char *)"lru",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_lru_tests
+	},
+	{
+		.pName = (char *)"phash",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_phash_tests
+	},
 	{
 		.pName = (char *)"random",
 		.pInitFunc = NULL,
 		.pCleanupFunc = NULL,
 		.pTests = s_random_tests
 	},
+	{
+		.pName = (char *)"rbtree",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_rbtree_tests
+	},
+	{
+		.pName = (char *)"slotmap",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_slotmap_tests
+	},
+	{
+		.pName = (char *)"strhash",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_strhash_tests
+	},
 	{
 		.pName = (char *)"varint",
 		.pInitFunc = NULL,
 		.pCleanupFunc = NULL,
 		.pTests = s_varint_tests
 	},
+	{
+		.pName = (char *)"vec",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_vec_tests
+	},
 	{
 		.pName = (char *)"timetools",
 		.pInitFunc = NULL,
 		.pCleanupFunc = NULL,
 		.pTests = s_timetools_tests
 	},
+	{
+		.pName = (char *)"timerwheel",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_timerwheel_tests
+	},
 #if defined(linux) && !defined(__ANDROID__)
 	{
 		.pName = (char *)"string",
@@ -134,6 +229,12 @@ static CU_SuiteInfo s_suites[] = {
 		.pCleanupFunc = NULL,
 		.pTests = s_fs_cpp_tests
 	},
+	{
+		.pName = (char *)"hashmap_cpp",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_hashmap_cpp_tests
+	},
 #endif
 #ifndef _WIN32
 	{
@@ -142,6 +243,26 @@ static CU_SuiteInfo s_suites[] = {
 		.pCleanupFunc = NULL,
 		.pTests = s_safew_tests
 	},
+	{
+		.pName = (char *)"mpscq",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_mpscq_tests
+	},
+#endif
+#if !defined(_WIN32) && !defined(__hexagon__)
+	{
+		.pName = (char *)"chash",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_chash_tests
+	},
+	{
+		.pName = (char *)"spsc",
+		.pInitFunc = NULL,
+		.pCleanupFunc = NULL,
+		.pTests = s_spsc_tests
+	},
 #endif
 	CU_SUITE_INFO_NULL,
 };
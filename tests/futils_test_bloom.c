@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_bloom.c
+ *
+ * @brief bloom unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_KEYS 10000
+
+static void test_bloom_invalid(void)
+{
+	struct futils_bloom *bloom;
+	int ret;
+
+	bloom = futils_bloom_new(100, 0);
+	CU_ASSERT_PTR_NULL(bloom);
+
+	ret = futils_bloom_add_u32(NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_bloom_test_u32(NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_bloom_add_bytes(NULL, "a", 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_bloom_clear(NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	futils_bloom_destroy(NULL);
+
+	/* empty filter has no key */
+	bloom = futils_bloom_new(0, 10);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bloom);
+	ret = futils_bloom_test_u32(bloom, 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_bloom_add_bytes(bloom, NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	futils_bloom_destroy(bloom);
+}
+
+static void test_bloom_u32(void)
+{
+	struct futils_bloom *bloom;
+	uint32_t i, fp = 0;
+	int ret;
+
+	bloom = futils_bloom_new(NB_TEST_KEYS, 10);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bloom);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_bloom_add_u32(bloom, i * 2);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	/* no false negative, and about 1% of false positives */
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_bloom_test_u32(bloom, i * 2);
+		CU_ASSERT_EQUAL(ret, 1);
+		fp += futils_bloom_test_u32(bloom, i * 2 + 1);
+	}
+	CU_ASSERT(fp < NB_TEST_KEYS / 30);
+
+	ret = futils_bloom_clear(bloom);
+	CU_ASSERT_EQUAL(ret, 0);
+	for (i = 0; i < NB_TEST_KEYS; i++)
+		CU_ASSERT_EQUAL(futils_bloom_test_u32(bloom, i * 2), 0);
+
+	futils_bloom_destroy(bloom);
+}
+
+static void test_bloom_bytes(void)
+{
+	struct futils_bloom *bloom;
+	char key[32];
+	uint32_t i, fp = 0;
+	int ret;
+
+	bloom = futils_bloom_new(NB_TEST_KEYS, 10);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(bloom);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		snprintf(key, sizeof(key), "key-%u", i);
+		ret = futils_bloom_add_bytes(bloom, key, strlen(key));
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		snprintf(key, sizeof(key), "key-%u", i);
+		ret = futils_bloom_test_bytes(bloom, key, strlen(key));
+		CU_ASSERT_EQUAL(ret, 1);
+		snprintf(key, sizeof(key), "miss-%u", i);
+		fp += futils_bloom_test_bytes(bloom, key, strlen(key));
+	}
+	CU_ASSERT(fp < NB_TEST_KEYS / 30);
+
+	futils_bloom_destroy(bloom);
+}
+
+CU_TestInfo s_bloom_tests[] = {
+	{(char *)"invalid", &test_bloom_invalid},
+	{(char *)"u32", &test_bloom_u32},
+	{(char *)"bytes", &test_bloom_bytes},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_chash.c
+ *
+ * @brief concurrent hash unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#include <pthread.h>
+
+#define NB_TEST_KEYS 4096
+#define NB_TEST_READERS 4
+#define NB_TEST_ROUNDS 20
+
+static int s_values[NB_TEST_KEYS];
+
+struct chash_test_reader {
+	struct futils_chash *hash;
+	pthread_t thread;
+	int errors;
+};
+
+static void *chash_test_reader_thread(void *arg)
+{
+	struct chash_test_reader *reader = arg;
+	void *data;
+	int i, round, ret;
+
+	for (round = 0; round < NB_TEST_ROUNDS; round++) {
+		for (i = 0; i < NB_TEST_KEYS; i++) {
+			ret = futils_chash_lookup(reader->hash, i, &data);
+			/* odd keys are never removed */
+			if (i % 2 == 1 && (ret != 0 || data != &s_values[i]))
+				reader->errors++;
+			/* even keys come and go */
+			if (i % 2 == 0 && ret == 0 && data != &s_values[i])
+				reader->errors++;
+			if (ret != 0 && ret != -ENOENT)
+				reader->errors++;
+		}
+	}
+	return NULL;
+}
+
+static void test_chash_concurrent(void)
+{
+	struct futils_chash *hash;
+	struct chash_test_reader readers[NB_TEST_READERS];
+	int i, round, ret;
+
+	hash = futils_chash_new(0, NULL);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(hash);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_chash_insert(hash, i, &s_values[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_chash_insert(hash, 0, &s_values[0]);
+	CU_ASSERT_EQUAL(ret, -EEXIST);
+
+	for (i = 0; i < NB_TEST_READERS; i++) {
+		readers[i].hash = hash;
+		readers[i].errors = 0;
+		ret = pthread_create(&readers[i].thread, NULL,
+				     &chash_test_reader_thread, &readers[i]);
+		CU_ASSERT_EQUAL_FATAL(ret, 0);
+	}
+
+	/* remove and insert even keys while readers are running */
+	for (round = 0; round < NB_TEST_ROUNDS; round++) {
+		for (i = 0; i < NB_TEST_KEYS; i += 2) {
+			ret = futils_chash_remove(hash, i);
+			CU_ASSERT_EQUAL(ret, 0);
+		}
+		for (i = 0; i < NB_TEST_KEYS; i += 2) {
+			ret = futils_chash_insert(hash, i, &s_values[i]);
+			CU_ASSERT_EQUAL(ret, 0);
+		}
+	}
+
+	for (i = 0; i < NB_TEST_READERS; i++) {
+		pthread_join(readers[i].thread, NULL);
+		CU_ASSERT_EQUAL(readers[i].errors, 0);
+	}
+
+	ret = futils_chash_remove_all(hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_chash_lookup(hash, 1, NULL);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	futils_chash_destroy(hash);
+}
+
+static void test_chash_const(void)
+{
+	struct futils_chash *hash;
+	static const int cvalue = 1;
+	const void *cdata;
+	void *data;
+	int ret;
+
+	hash = futils_chash_new(16, NULL);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(hash);
+
+	ret = futils_chash_insert_const(hash, 7, &cvalue);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_chash_lookup(hash, 7, &data);
+	CU_ASSERT_EQUAL(ret, -EPERM);
+	ret = futils_chash_lookup_const(hash, 7, &cdata);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(cdata, &cvalue);
+
+	futils_chash_destroy(hash);
+}
+
+CU_TestInfo s_chash_tests[] = {
+	{(char *)"concurrent", &test_chash_concurrent},
+	{(char *)"const", &test_chash_const},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_deque.c
+ *
+ * @brief deque unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_ELEMS 1000
+
+static void test_deque_basic(void)
+{
+	struct futils_deque *d;
+	uint32_t i, value;
+	int ret;
+
+	d = futils_deque_new(0, 0);
+	CU_ASSERT_PTR_NULL(d);
+	ret = futils_deque_push_back(NULL, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_deque_pop_front(NULL, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	d = futils_deque_new(sizeof(uint32_t), 16);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(d);
+	CU_ASSERT_EQUAL(futils_deque_count(d), 0);
+	CU_ASSERT_PTR_NULL(futils_deque_front(d));
+	CU_ASSERT_PTR_NULL(futils_deque_back(d));
+	ret = futils_deque_pop_front(d, &value);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	ret = futils_deque_pop_back(d, &value);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	/* fifo */
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_push_back(d, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(futils_deque_count(d), NB_TEST_ELEMS);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_deque_front(d), 0);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_deque_back(d), NB_TEST_ELEMS - 1);
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_pop_front(d, &value);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL(value, i);
+	}
+	CU_ASSERT_EQUAL(futils_deque_count(d), 0);
+
+	/* lifo from front */
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_push_front(d, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_pop_front(d, &value);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL(value, NB_TEST_ELEMS - 1 - i);
+	}
+
+	/* push front, pop back */
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_push_front(d, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_deque_pop_back(d, &value);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL(value, i);
+	}
+	CU_ASSERT_EQUAL(futils_deque_count(d), 0);
+
+	/* zeroed element */
+	ret = futils_deque_push_back(d, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_deque_back(d), 0);
+
+	ret = futils_deque_clear(d);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(futils_deque_count(d), 0);
+
+	futils_deque_destroy(d);
+}
+
+static void test_deque_random(void)
+{
+	struct futils_deque *d;
+	uint32_t ref[2 * NB_TEST_ELEMS];
+	size_t head = NB_TEST_ELEMS, tail = NB_TEST_ELEMS;
+	uint32_t i, value;
+	int ret;
+
+	/* check against an array large enough to never wrap */
+	d = futils_deque_new(sizeof(uint32_t), 7);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(d);
+
+	srand(1);
+	for (i = 0; i < 20 * NB_TEST_ELEMS; i++) {
+		switch (rand() % 4) {
+		case 0:
+			if (tail == 2 * NB_TEST_ELEMS)
+				break;
+			ret = futils_deque_push_back(d, &i);
+			CU_ASSERT_EQUAL(ret, 0);
+			ref[tail++] = i;
+			break;
+		case 1:
+			if (head == 0)
+				break;
+			ret = futils_deque_push_front(d, &i);
+			CU_ASSERT_EQUAL(ret, 0);
+			ref[--head] = i;
+			break;
+		case 2:
+			ret = futils_deque_pop_back(d, &value);
+			if (head == tail) {
+				CU_ASSERT_EQUAL(ret, -ENOENT);
+				break;
+			}
+			CU_ASSERT_EQUAL(ret, 0);
+			CU_ASSERT_EQUAL(value, ref[--tail]);
+			break;
+		default:
+			ret = futils_deque_pop_front(d, &value);
+			if (head == tail) {
+				CU_ASSERT_EQUAL(ret, -ENOENT);
+				break;
+			}
+			CU_ASSERT_EQUAL(ret, 0);
+			CU_ASSERT_EQUAL(value, ref[head++]);
+			break;
+		}
+
+		CU_ASSERT_EQUAL(futils_deque_count(d), tail - head);
+		if (head == tail) {
+			/* recenter reference */
+			head = NB_TEST_ELEMS;
+			tail = NB_TEST_ELEMS;
+		}
+	}
+
+	futils_deque_destroy(d);
+}
+
+CU_TestInfo s_deque_tests[] = {
+	{(char *)"basic", &test_deque_basic},
+	{(char *)"random", &test_deque_random},
+	CU_TEST_INFO_NULL,
+};
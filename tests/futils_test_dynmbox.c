@@ -551,6 +551,105 @@ static void test_dynmbox_push_block(void)
 	dynmbox_destroy(box);
 }
 
+struct peek_all_ctx {
+	unsigned int count;
+	size_t total;
+	int errors;
+};
+
+static void peek_all_cb(const void *msg, size_t msg_size, void *userdata)
+{
+	struct peek_all_ctx *ctx = userdata;
+	const uint8_t *bytes = msg;
+	size_t i;
+
+	/* messages are filled with their index, with index as size */
+	if (msg_size != (ctx->count % 1000) + 1)
+		ctx->errors++;
+	for (i = 0; i < msg_size; i++) {
+		if (bytes[i] != (uint8_t)ctx->count)
+			ctx->errors++;
+	}
+	ctx->count++;
+	ctx->total += msg_size;
+}
+
+static int fd_is_readable(int fd)
+{
+	fd_set rfds;
+	struct timeval timeout = {0, 0};
+
+	FD_ZERO(&rfds);
+	FD_SET(fd, &rfds);
+	return select(fd + 1, &rfds, NULL, NULL, &timeout) == 1;
+}
+
+static void test_dynmbox_peek_all(void)
+{
+	static uint8_t msg[1000];
+	struct peek_all_ctx ctx;
+	struct dynmbox *box;
+	unsigned int pushed = 0, i, round;
+	ssize_t len;
+	int fd, res;
+
+	init_winsock();
+
+	box = dynmbox_new(sizeof(msg));
+	CU_ASSERT_PTR_NOT_NULL_FATAL(box);
+	fd = dynmbox_get_read_fd(box);
+	CU_ASSERT(fd >= 0);
+
+	/* Invalid arguments */
+	res = dynmbox_peek_all(NULL, peek_all_cb, &ctx);
+	CU_ASSERT_EQUAL(res, -EINVAL);
+	res = dynmbox_peek_all(box, NULL, &ctx);
+	CU_ASSERT_EQUAL(res, -EINVAL);
+
+	/* Empty mbox */
+	memset(&ctx, 0, sizeof(ctx));
+	res = dynmbox_peek_all(box, peek_all_cb, &ctx);
+	CU_ASSERT_EQUAL(res, -EAGAIN);
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	/* Read fd stays readable until mbox is empty */
+	res = dynmbox_push(box, msg, 1);
+	CU_ASSERT_EQUAL(res, 0);
+	res = dynmbox_push(box, msg, 1);
+	CU_ASSERT_EQUAL(res, 0);
+	CU_ASSERT_TRUE(fd_is_readable(fd));
+	len = dynmbox_peek(box, msg);
+	CU_ASSERT_EQUAL(len, 1);
+	CU_ASSERT_TRUE(fd_is_readable(fd));
+	len = dynmbox_peek(box, msg);
+	CU_ASSERT_EQUAL(len, 1);
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	/* Fill and drain several times, so that messages wrap around the
+	 * ring end */
+	for (round = 0; round < 10; round++) {
+		for (;;) {
+			memset(msg, pushed, sizeof(msg));
+			res = dynmbox_push(box, msg, (pushed % 1000) + 1);
+			if (res < 0)
+				break;
+			pushed++;
+		}
+		CU_ASSERT_EQUAL(res, -EAGAIN);
+		CU_ASSERT_TRUE(fd_is_readable(fd));
+
+		i = ctx.count;
+		res = dynmbox_peek_all(box, peek_all_cb, &ctx);
+		CU_ASSERT(res > 0);
+		CU_ASSERT_EQUAL((unsigned int)res, ctx.count - i);
+		CU_ASSERT_EQUAL(ctx.count, pushed);
+		CU_ASSERT_EQUAL(ctx.errors, 0);
+		CU_ASSERT_FALSE(fd_is_readable(fd));
+	}
+
+	dynmbox_destroy(box);
+}
+
 CU_TestInfo s_dynmbox_tests[] = {
 	{(char *)"dynmbox creation", &test_dynmbox_creation},
 	{(char *)"dynmbox get read fd", &test_dynmbox_get_read_fd},
@@ -571,5 +670,7 @@ CU_TestInfo s_dynmbox_tests[] = {
 		&test_dynmbox_concurrent},
 	{(char *)"dynmbox push_block",
 		&test_dynmbox_push_block},
+	{(char *)"dynmbox peek_all",
+		&test_dynmbox_peek_all},
 	CU_TEST_INFO_NULL,
 };
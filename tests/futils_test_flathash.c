@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_flathash.c
+ *
+ * @brief flathash unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_KEYS 10000
+
+static int s_free_count;
+
+static void test_free(void *data)
+{
+	s_free_count++;
+}
+
+static void test_flathash_invalid(void)
+{
+	struct futils_flathash hash;
+	void *data;
+	int ret;
+
+	ret = futils_flathash_init(NULL, 0, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_flathash_insert(NULL, 1, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_flathash_lookup(NULL, 1, &data);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_flathash_remove(NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_flathash_destroy(NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	ret = futils_flathash_init(&hash, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_flathash_lookup(&hash, 1, &data);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	ret = futils_flathash_remove(&hash, 1);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	futils_flathash_destroy(&hash);
+}
+
+static void test_flathash_const(void)
+{
+	struct futils_flathash hash;
+	static const int value = 42;
+	const void *cdata;
+	void *data;
+	int ret;
+
+	ret = futils_flathash_init(&hash, 4, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	ret = futils_flathash_insert_const(&hash, 3, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_flathash_insert(&hash, 3, NULL);
+	CU_ASSERT_EQUAL(ret, -EEXIST);
+
+	/* const entries can only be looked up with the const variant */
+	ret = futils_flathash_lookup(&hash, 3, &data);
+	CU_ASSERT_EQUAL(ret, -EPERM);
+	ret = futils_flathash_lookup_const(&hash, 3, &cdata);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(cdata, &value);
+
+	futils_flathash_destroy(&hash);
+}
+
+static void test_flathash_many(void)
+{
+	struct futils_flathash hash;
+	static int values[NB_TEST_KEYS];
+	uint32_t key;
+	void *data;
+	int i, ret;
+
+	s_free_count = 0;
+
+	/* start small to exercise growth */
+	ret = futils_flathash_init(&hash, 1, &test_free);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		key = (uint32_t)i * 2654435761U;
+		ret = futils_flathash_insert(&hash, key, &values[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(hash.count, NB_TEST_KEYS);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		key = (uint32_t)i * 2654435761U;
+		ret = futils_flathash_lookup(&hash, key, &data);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_PTR_EQUAL(data, &values[i]);
+	}
+
+	/* remove even entries */
+	for (i = 0; i < NB_TEST_KEYS; i += 2) {
+		key = (uint32_t)i * 2654435761U;
+		ret = futils_flathash_remove(&hash, key);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(s_free_count, NB_TEST_KEYS / 2);
+	CU_ASSERT_EQUAL(hash.count, NB_TEST_KEYS / 2);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		key = (uint32_t)i * 2654435761U;
+		ret = futils_flathash_lookup(&hash, key, &data);
+		if (i % 2 == 0) {
+			CU_ASSERT_EQUAL(ret, -ENOENT);
+		} else {
+			CU_ASSERT_EQUAL(ret, 0);
+			CU_ASSERT_PTR_EQUAL(data, &values[i]);
+		}
+	}
+
+	ret = futils_flathash_remove_all(&hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_free_count, NB_TEST_KEYS);
+	CU_ASSERT_EQUAL(hash.count, 0);
+
+	futils_flathash_destroy(&hash);
+}
+
+CU_TestInfo s_flathash_tests[] = {
+	{(char *)"invalid", &test_flathash_invalid},
+	{(char *)"const", &test_flathash_const},
+	{(char *)"many", &test_flathash_many},
+	CU_TEST_INFO_NULL,
+};
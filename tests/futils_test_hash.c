@@ -0,0 +1,330 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_hash.c
+ *
+ * @brief hash unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_KEYS 5000
+
+static void test_hash_basic(void)
+{
+	struct hash hash;
+	static const int cvalue = 1;
+	int value = 2;
+	const void *cdata;
+	void *data;
+	int ret;
+
+	ret = futils_hash_init(&hash, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	ret = futils_hash_insert(&hash, 1, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_hash_insert(&hash, 1, &value);
+	CU_ASSERT_EQUAL(ret, -EEXIST);
+	ret = futils_hash_insert_const(&hash, 2, &cvalue);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(hash.count, 2);
+
+	ret = futils_hash_lookup(&hash, 1, &data);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(data, &value);
+	ret = futils_hash_lookup(&hash, 2, &data);
+	CU_ASSERT_EQUAL(ret, -EPERM);
+	ret = futils_hash_lookup_const(&hash, 2, &cdata);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(cdata, &cvalue);
+	ret = futils_hash_lookup(&hash, 3, &data);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	ret = futils_hash_remove(&hash, 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_hash_remove(&hash, 1);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	CU_ASSERT_EQUAL(hash.count, 1);
+
+	futils_hash_destroy(&hash);
+}
+
+static void test_hash_auto_resize(void)
+{
+	struct hash hash;
+	static int values[NB_TEST_KEYS];
+	uint32_t size;
+	void *data;
+	int i, j, ret;
+
+	ret = futils_hash_init(&hash, 1, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	size = hash.size;
+
+	ret = futils_hash_set_auto_resize(&hash, 100);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_hash_insert(&hash, i, &values[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+
+		/* all entries stay reachable during migrations */
+		if (i % 97 == 0) {
+			for (j = 0; j <= i; j++) {
+				ret = futils_hash_lookup(&hash, j, &data);
+				CU_ASSERT_EQUAL(ret, 0);
+				CU_ASSERT_PTR_EQUAL(data, &values[j]);
+			}
+		}
+	}
+
+	CU_ASSERT(hash.size > size);
+	CU_ASSERT(hash.count <= hash.size);
+	CU_ASSERT_EQUAL(list_length(&hash.entries), NB_TEST_KEYS);
+
+	/* remove half of entries, the other half must stay reachable */
+	for (i = 0; i < NB_TEST_KEYS; i += 2) {
+		ret = futils_hash_remove(&hash, i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_hash_lookup(&hash, i, &data);
+		CU_ASSERT_EQUAL(ret, (i % 2 == 0) ? -ENOENT : 0);
+	}
+	CU_ASSERT_EQUAL(hash.count, NB_TEST_KEYS / 2);
+
+	ret = futils_hash_remove_all(&hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_NULL(hash.old_buckets);
+	CU_ASSERT_EQUAL(hash.count, 0);
+	CU_ASSERT_TRUE(list_is_empty(&hash.entries));
+
+	futils_hash_destroy(&hash);
+}
+
+struct hash_test_object {
+	int value;
+	struct hash_entry entry;
+};
+
+static void test_hash_intrusive(void)
+{
+	struct hash hash;
+	struct hash_test_object *objects;
+	struct hash_test_object other;
+	struct hash_test_object *obj;
+	struct hash_entry *entry;
+	int i, ret;
+
+	objects = calloc(NB_TEST_KEYS, sizeof(*objects));
+	CU_ASSERT_PTR_NOT_NULL_FATAL(objects);
+
+	ret = futils_hash_init(&hash, NB_TEST_KEYS, &free);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		objects[i].value = i;
+		ret = futils_hash_link(&hash, i, &objects[i].entry);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_hash_link(&hash, 0, &other.entry);
+	CU_ASSERT_EQUAL(ret, -EEXIST);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_hash_lookup_entry(&hash, i, &entry);
+		CU_ASSERT_EQUAL_FATAL(ret, 0);
+		obj = futils_hash_entry(entry, struct hash_test_object, entry);
+		CU_ASSERT_PTR_EQUAL(obj, &objects[i]);
+		CU_ASSERT_EQUAL(obj->value, i);
+	}
+
+	/* an entry not linked in table can not be unlinked */
+	other.entry.key = 1;
+	ret = futils_hash_unlink(&hash, &other.entry);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	ret = futils_hash_unlink(&hash, &objects[1].entry);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_hash_lookup_entry(&hash, 1, &entry);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	/* removing caller owned entries must not free them */
+	ret = futils_hash_remove(&hash, 2);
+	CU_ASSERT_EQUAL(ret, 0);
+	futils_hash_destroy(&hash);
+	free(objects);
+}
+
+static void test_hash_lookup_batch(void)
+{
+	struct hash hash;
+	static int values[NB_TEST_KEYS];
+	static const int cvalue = 1;
+	static uint32_t keys[NB_TEST_KEYS + 2];
+	static void *out[NB_TEST_KEYS + 2];
+	static const void *cout[NB_TEST_KEYS + 2];
+	int i, ret;
+
+	ret = futils_hash_init(&hash, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	futils_hash_set_auto_resize(&hash, 100);
+
+	for (i = 0; i < NB_TEST_KEYS; i += 2) {
+		ret = futils_hash_insert(&hash, i, &values[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_hash_insert_const(&hash, NB_TEST_KEYS, &cvalue);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	for (i = 0; i < NB_TEST_KEYS + 2; i++)
+		keys[i] = i;
+
+	ret = futils_hash_lookup_batch(NULL, keys, 1, out);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_hash_lookup_batch(&hash, keys, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* const entry is not returned by the non const variant */
+	ret = futils_hash_lookup_batch(&hash, keys, NB_TEST_KEYS + 2, out);
+	CU_ASSERT_EQUAL(ret, NB_TEST_KEYS / 2);
+	for (i = 0; i < NB_TEST_KEYS + 2; i++) {
+		if (i < NB_TEST_KEYS && i % 2 == 0) {
+			CU_ASSERT_PTR_EQUAL(out[i], &values[i]);
+		} else {
+			CU_ASSERT_PTR_NULL(out[i]);
+		}
+	}
+
+	ret = futils_hash_lookup_batch_const(&hash, keys, NB_TEST_KEYS + 2,
+					     cout);
+	CU_ASSERT_EQUAL(ret, NB_TEST_KEYS / 2 + 1);
+	CU_ASSERT_PTR_EQUAL(cout[NB_TEST_KEYS], &cvalue);
+	CU_ASSERT_PTR_NULL(cout[NB_TEST_KEYS + 1]);
+
+	futils_hash_destroy(&hash);
+}
+
+/**
+ * keys with the same hash: the hash is djb2 over the key bytes, least
+ * significant first, so adding 1 to byte 2 and removing 33 from byte 3 does not
+ * change it
+ */
+#define HASH_STATS_COLLIDE_KEY(_i) \
+	((((uint32_t)(165 - 33 * (_i))) << 24) | ((uint32_t)(_i) << 16))
+
+#define HASH_STATS_NB_COLLIDE 5
+#define HASH_STATS_NB_SINGLE 3
+
+static void test_hash_stats(void)
+{
+	struct hash hash;
+	struct futils_hash_stats stats;
+	uint32_t i, total, probes = 0;
+	int ret;
+
+	ret = futils_hash_init(&hash, 100, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_hash_enable_counters(&hash, 1);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* one chain of 5 entries */
+	for (i = 0; i < HASH_STATS_NB_COLLIDE; i++) {
+		ret = futils_hash_insert(&hash, HASH_STATS_COLLIDE_KEY(i),
+					 NULL);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	/* small keys land in distinct buckets, away from the chain above */
+	for (i = 1; i <= HASH_STATS_NB_SINGLE; i++) {
+		ret = futils_hash_insert(&hash, i, NULL);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	ret = futils_hash_get_stats(&hash, &stats);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(stats.size, hash.size);
+	CU_ASSERT_EQUAL(stats.count, 8);
+	CU_ASSERT_EQUAL(stats.load_factor, 8 * 100 / hash.size);
+	CU_ASSERT_EQUAL(stats.max_chain, HASH_STATS_NB_COLLIDE);
+	CU_ASSERT_EQUAL(stats.used_buckets, 1 + HASH_STATS_NB_SINGLE);
+	CU_ASSERT_EQUAL(stats.chain_hist[0], hash.size - stats.used_buckets);
+	CU_ASSERT_EQUAL(stats.chain_hist[1], HASH_STATS_NB_SINGLE);
+	CU_ASSERT_EQUAL(stats.chain_hist[HASH_STATS_NB_COLLIDE], 1);
+	total = 0;
+	for (i = 0; i < FUTILS_HASH_STATS_HIST_LEN; i++)
+		total += stats.chain_hist[i];
+	CU_ASSERT_EQUAL(total, hash.size);
+	CU_ASSERT_EQUAL(stats.lookups, 0);
+	CU_ASSERT_EQUAL(stats.probes, 0);
+
+	/* entries are inserted at chain head: the first one is the deepest */
+	for (i = 0; i < HASH_STATS_NB_COLLIDE; i++) {
+		ret = futils_hash_lookup(&hash, HASH_STATS_COLLIDE_KEY(i),
+					 NULL);
+		CU_ASSERT_EQUAL(ret, 0);
+		ret = futils_hash_get_stats(&hash, &stats);
+		CU_ASSERT_EQUAL(ret, 0);
+		probes += HASH_STATS_NB_COLLIDE - i;
+		CU_ASSERT_EQUAL(stats.lookups, i + 1);
+		CU_ASSERT_EQUAL(stats.probes, probes);
+	}
+
+	/* a missing key with the same hash walks the whole chain */
+	ret = futils_hash_lookup(&hash,
+				 HASH_STATS_COLLIDE_KEY(HASH_STATS_NB_COLLIDE),
+				 NULL);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	for (i = 1; i <= HASH_STATS_NB_SINGLE; i++) {
+		ret = futils_hash_lookup(&hash, i, NULL);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_hash_get_stats(&hash, &stats);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(stats.lookups,
+			HASH_STATS_NB_COLLIDE + 1 + HASH_STATS_NB_SINGLE);
+	CU_ASSERT_EQUAL(stats.probes,
+			probes + HASH_STATS_NB_COLLIDE + HASH_STATS_NB_SINGLE);
+
+	ret = futils_hash_enable_counters(&hash, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	futils_hash_lookup(&hash, 1, NULL);
+	ret = futils_hash_get_stats(&hash, &stats);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(stats.lookups, 0);
+	CU_ASSERT_EQUAL(stats.probes, 0);
+
+	futils_hash_destroy(&hash);
+}
+
+CU_TestInfo s_hash_tests[] = {
+	{(char *)"basic", &test_hash_basic},
+	{(char *)"auto_resize", &test_hash_auto_resize},
+	{(char *)"intrusive", &test_hash_intrusive},
+	{(char *)"lookup_batch", &test_hash_lookup_batch},
+	{(char *)"stats", &test_hash_stats},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_hashmap.cpp
+ *
+ * @brief libfutils cpp hash map unit tests.
+ *
+ */
+
+#include "futils_test.h"
+#include <memory>
+#include <string>
+
+static void test_hashmap_basic(void)
+{
+	futils::HashMap<uint32_t, int> map;
+	int i;
+
+	CU_ASSERT_TRUE(map.empty());
+	CU_ASSERT_TRUE(map.find(1) == map.end());
+	CU_ASSERT_EQUAL(map.erase(1), 0);
+
+	for (i = 0; i < 1000; i++) {
+		auto res = map.emplace(i * 3, i);
+		CU_ASSERT_TRUE(res.second);
+		CU_ASSERT_EQUAL(res.first.key(), (uint32_t)i * 3);
+		CU_ASSERT_EQUAL(res.first.value(), i);
+	}
+	CU_ASSERT_EQUAL(map.size(), 1000);
+
+	/* duplicate key */
+	auto res = map.emplace(3, 42);
+	CU_ASSERT_FALSE(res.second);
+	CU_ASSERT_EQUAL(res.first.value(), 1);
+
+	for (i = 0; i < 1000; i++) {
+		auto it = map.find(i * 3);
+		CU_ASSERT_TRUE(it != map.end());
+		if (it != map.end())
+			CU_ASSERT_EQUAL(it->second, i);
+		CU_ASSERT_EQUAL(map.count(i * 3 + 1), 0);
+	}
+
+	/* iteration visits each entry once */
+	int sum = 0;
+	size_t n = 0;
+	for (auto it = map.begin(); it != map.end(); ++it) {
+		sum += it.value();
+		n++;
+	}
+	CU_ASSERT_EQUAL(n, 1000);
+	CU_ASSERT_EQUAL(sum, 999 * 1000 / 2);
+
+	/* values are modifiable through iterators */
+	for (auto it = map.begin(); it != map.end(); ++it)
+		it->second *= 2;
+	for (auto &entry : map)
+		entry.second++;
+	const futils::HashMap<uint32_t, int> &cmap = map;
+	sum = 0;
+	for (auto it = cmap.begin(); it != cmap.end(); ++it)
+		sum += it->second;
+	CU_ASSERT_EQUAL(sum, 999 * 1000 + 1000);
+	CU_ASSERT_EQUAL(map.find(3)->second, 3);
+
+	/* remove half of the entries */
+	for (i = 0; i < 1000; i += 2)
+		CU_ASSERT_EQUAL(map.erase(i * 3), 1);
+	CU_ASSERT_EQUAL(map.size(), 500);
+	for (i = 0; i < 1000; i++)
+		CU_ASSERT_EQUAL(map.count(i * 3), (size_t)(i % 2));
+
+	map[7] = 77;
+	CU_ASSERT_EQUAL(map[7], 77);
+	map.erase(map.find(7));
+	CU_ASSERT_EQUAL(map.count(7), 0);
+
+	map.clear();
+	CU_ASSERT_TRUE(map.empty());
+	CU_ASSERT_TRUE(map.begin() == map.end());
+}
+
+static void test_hashmap_move_only(void)
+{
+	futils::HashMap<int, std::unique_ptr<int>> map(4);
+	int i;
+
+	for (i = 0; i < 100; i++) {
+		auto res = map.try_emplace(i, new int(i));
+		CU_ASSERT_TRUE(res.second);
+	}
+
+	/* value is not constructed for an existing key */
+	auto res = map.try_emplace(5);
+	CU_ASSERT_FALSE(res.second);
+	CU_ASSERT_EQUAL(*res.first.value(), 5);
+
+	for (i = 0; i < 100; i += 3)
+		map.erase(i);
+	for (i = 0; i < 100; i++) {
+		auto it = map.find(i);
+		if (i % 3 == 0) {
+			CU_ASSERT_TRUE(it == map.end());
+		} else {
+			CU_ASSERT_TRUE(it != map.end());
+			if (it != map.end())
+				CU_ASSERT_EQUAL(*it.value(), i);
+		}
+	}
+
+	futils::HashMap<int, std::unique_ptr<int>> other(std::move(map));
+	CU_ASSERT_EQUAL(map.size(), 0);
+	CU_ASSERT_EQUAL(other.size(), 66);
+	CU_ASSERT_EQUAL(*other.find(1).value(), 1);
+}
+
+static void test_hashmap_string(void)
+{
+	futils::HashMap<std::string, std::string> map;
+	const char *key = "key";
+
+	map.reserve(100);
+	map.emplace(std::string("key"), std::string("value"));
+	map.try_emplace("other", 3, 'x');
+	CU_ASSERT_EQUAL(map.size(), 2);
+
+	/* heterogeneous lookup, no std::string is built */
+	auto it = map.find(key);
+	CU_ASSERT_TRUE(it != map.end());
+	if (it != map.end())
+		CU_ASSERT_TRUE(it.value() == "value");
+	CU_ASSERT_EQUAL(map.count("other"), 1);
+	CU_ASSERT_TRUE(map.find("other").value() == "xxx");
+	CU_ASSERT_EQUAL(map.count("missing"), 0);
+
+	const futils::HashMap<std::string, std::string> &cmap = map;
+	futils::HashMap<std::string, std::string>::const_iterator cit =
+		cmap.find(std::string("key"));
+	CU_ASSERT_TRUE(cit != cmap.end());
+
+	CU_ASSERT_EQUAL(map.erase("key"), 1);
+	CU_ASSERT_EQUAL(map.size(), 1);
+}
+
+CU_TestInfo s_hashmap_cpp_tests[] = {
+	{(char *)"basic", &test_hashmap_basic},
+	{(char *)"move_only", &test_hashmap_move_only},
+	{(char *)"string", &test_hashmap_string},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_heap.c
+ *
+ * @brief heap unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_NODES 5000
+
+struct heap_test_item {
+	struct futils_heap_node node;
+	int prio;
+};
+
+static struct heap_test_item s_items[NB_TEST_NODES];
+
+/* higher priority first */
+static int heap_test_cmp(const struct futils_heap_node *a,
+			 const struct futils_heap_node *b)
+{
+	const struct heap_test_item *ia = futils_heap_entry(a,
+			struct heap_test_item, node);
+	const struct heap_test_item *ib = futils_heap_entry(b,
+			struct heap_test_item, node);
+
+	return ib->prio - ia->prio;
+}
+
+static void test_heap_basic(void)
+{
+	struct futils_heap heap;
+	struct futils_heap_node *node;
+	uint64_t prev;
+	uint32_t i, rnd = 1;
+	int ret;
+
+	ret = futils_heap_init(NULL, 0, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_heap_init(&heap, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_NULL(futils_heap_top(&heap));
+	CU_ASSERT_PTR_NULL(futils_heap_pop(&heap));
+
+	for (i = 0; i < NB_TEST_NODES; i++) {
+		rnd = rnd * 1103515245 + 12345;
+		futils_heap_node_init(&s_items[i].node, (rnd >> 8) % 1000);
+		ret = futils_heap_push(&heap, &s_items[i].node);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_TRUE(futils_heap_node_is_queued(&s_items[i].node));
+	}
+	CU_ASSERT_EQUAL(futils_heap_count(&heap), NB_TEST_NODES);
+
+	/* already queued */
+	ret = futils_heap_push(&heap, &s_items[0].node);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	/* remove a third of the nodes, change key of another third */
+	for (i = 0; i < NB_TEST_NODES; i += 3) {
+		ret = futils_heap_remove(&heap, &s_items[i].node);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_FALSE(futils_heap_node_is_queued(&s_items[i].node));
+	}
+	ret = futils_heap_remove(&heap, &s_items[0].node);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	for (i = 1; i < NB_TEST_NODES; i += 3) {
+		s_items[i].node.key = (s_items[i].node.key * 7) % 1000;
+		ret = futils_heap_update(&heap, &s_items[i].node);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(futils_heap_count(&heap),
+			NB_TEST_NODES - (NB_TEST_NODES + 2) / 3);
+
+	/* nodes are popped in key order */
+	prev = 0;
+	while ((node = futils_heap_pop(&heap)) != NULL) {
+		CU_ASSERT(node->key >= prev);
+		CU_ASSERT_FALSE(futils_heap_node_is_queued(node));
+		prev = node->key;
+	}
+	CU_ASSERT_EQUAL(futils_heap_count(&heap), 0);
+
+	futils_heap_destroy(&heap);
+}
+
+static void test_heap_cmp(void)
+{
+	struct futils_heap heap;
+	struct futils_heap_node *node;
+	struct heap_test_item *item;
+	int i, prev, ret;
+
+	ret = futils_heap_init(&heap, 4, &heap_test_cmp);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	for (i = 0; i < 100; i++) {
+		s_items[i].prio = (i * 37) % 100;
+		futils_heap_node_init(&s_items[i].node, 0);
+		ret = futils_heap_push(&heap, &s_items[i].node);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	node = futils_heap_top(&heap);
+	item = futils_heap_entry(node, struct heap_test_item, node);
+	CU_ASSERT_EQUAL(item->prio, 99);
+
+	prev = 100;
+	while ((node = futils_heap_pop(&heap)) != NULL) {
+		item = futils_heap_entry(node, struct heap_test_item, node);
+		CU_ASSERT_EQUAL(item->prio, prev - 1);
+		prev = item->prio;
+	}
+	CU_ASSERT_EQUAL(prev, 0);
+
+	futils_heap_destroy(&heap);
+}
+
+CU_TestInfo s_heap_tests[] = {
+	{(char *)"basic", &test_heap_basic},
+	{(char *)"cmp", &test_heap_cmp},
+	CU_TEST_INFO_NULL,
+};
@@ -420,11 +420,109 @@ static void test_fifo(void)
 }
 
 
+struct list_sort_element {
+	int key;
+	int seq;
+	struct list_node node;
+};
+
+static int list_sort_cmp(void *priv, const struct list_node *a,
+			 const struct list_node *b)
+{
+	const struct list_sort_element *ea = list_entry(a,
+			struct list_sort_element, node);
+	const struct list_sort_element *eb = list_entry(b,
+			struct list_sort_element, node);
+
+	(*(int *)priv)++;
+	return ea->key - eb->key;
+}
+
+static void check_sorted(struct list_node *list, int count)
+{
+	struct list_sort_element *elem, *prev = NULL;
+	struct list_node *node;
+	int n = 0;
+
+	list_walk_entry_forward(list, elem, node) {
+		CU_ASSERT_PTR_EQUAL(elem->node.next->prev, &elem->node);
+		if (prev) {
+			CU_ASSERT(prev->key <= elem->key);
+			/* stable: equal keys keep their order */
+			if (prev->key == elem->key)
+				CU_ASSERT(prev->seq < elem->seq);
+		}
+		prev = elem;
+		n++;
+	}
+	CU_ASSERT_EQUAL(n, count);
+
+	/* backward links are consistent too */
+	n = 0;
+	list_walk_backward(list, node)
+		n++;
+	CU_ASSERT_EQUAL(n, count);
+}
+
+static void test_sort(void)
+{
+	static struct list_sort_element elements[1000];
+	struct list_node list, other;
+	int i, count, ncmp = 0;
+	unsigned int rnd = 1;
+
+	/* empty and single node lists */
+	list_init(&list);
+	list_sort(&list, &list_sort_cmp, &ncmp);
+	CU_ASSERT_TRUE(list_is_empty(&list));
+	elements[0].key = 0;
+	elements[0].seq = 0;
+	list_add_before(&list, &elements[0].node);
+	list_sort(&list, &list_sort_cmp, &ncmp);
+	check_sorted(&list, 1);
+	CU_ASSERT_EQUAL(ncmp, 0);
+
+	for (count = 2; count <= 1000; count = count * 3 + 1) {
+		list_init(&list);
+		for (i = 0; i < count; i++) {
+			rnd = rnd * 1103515245 + 12345;
+			elements[i].key = (rnd >> 16) % 50;
+			elements[i].seq = i;
+			list_add_before(&list, &elements[i].node);
+		}
+		list_sort(&list, &list_sort_cmp, &ncmp);
+		check_sorted(&list, count);
+	}
+
+	/* merge two sorted lists, nodes of list first on equality */
+	list_init(&list);
+	list_init(&other);
+	for (i = 0; i < 100; i++) {
+		elements[i].key = i / 2;
+		elements[i].seq = i < 50 ? i : i + 1000;
+		list_add_before(i < 50 ? &list : &other, &elements[i].node);
+	}
+	for (i = 0; i < 100; i++)
+		elements[i].key = (i % 50) * 2 / 3;
+	list_merge(&list, &other, &list_sort_cmp, &ncmp);
+	CU_ASSERT_TRUE(list_is_empty(&other));
+	check_sorted(&list, 100);
+
+	/* merge in empty list */
+	list_init(&list);
+	list_init(&other);
+	list_add_before(&other, &elements[0].node);
+	list_merge(&list, &other, &list_sort_cmp, &ncmp);
+	CU_ASSERT_TRUE(list_is_empty(&other));
+	check_sorted(&list, 1);
+}
+
 CU_TestInfo s_list_tests[] = {
 	{(char *)"list core", &test_core},
 	{(char *)"list insertion/deletion", &test_modif},
 	{(char *)"list iterators", &test_iter},
 	{(char *)"list safe iterators", &test_iter_safe},
 	{(char *)"list as a fifo", &test_fifo},
+	{(char *)"list sort", &test_sort},
 	CU_TEST_INFO_NULL,
 };
@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_lru.c
+ *
+ * @brief lru unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+static int s_released[16];
+
+static void test_release(uint32_t key, void *value, void *userdata)
+{
+	CU_ASSERT_PTR_EQUAL(userdata, s_released);
+	if (key < SIZEOF_ARRAY(s_released))
+		s_released[key]++;
+}
+
+static void test_lru_entries(void)
+{
+	struct futils_lru *lru;
+	struct futils_lru_stats stats;
+	int values[16];
+	void *value;
+	int ret;
+
+	memset(s_released, 0, sizeof(s_released));
+
+	lru = futils_lru_new(3, 0, &test_release, s_released);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(lru);
+
+	ret = futils_lru_put(lru, 1, &values[1], 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_lru_put(lru, 2, &values[2], 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_lru_put(lru, 3, &values[3], 1);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* make 1 most recently used, 2 is then evicted by 4 */
+	ret = futils_lru_get(lru, 1, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(value, &values[1]);
+	ret = futils_lru_put(lru, 4, &values[4], 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[2], 1);
+	ret = futils_lru_get(lru, 2, &value);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	/* replacing a value releases the previous one */
+	ret = futils_lru_put(lru, 3, &values[5], 1);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[3], 1);
+	ret = futils_lru_get(lru, 3, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(value, &values[5]);
+
+	ret = futils_lru_erase(lru, 4);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[4], 1);
+	ret = futils_lru_erase(lru, 4);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	ret = futils_lru_get_stats(lru, &stats);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(stats.hits, 2);
+	CU_ASSERT_EQUAL(stats.misses, 1);
+	CU_ASSERT_EQUAL(stats.evictions, 1);
+	CU_ASSERT_EQUAL(stats.entries, 2);
+	CU_ASSERT_EQUAL(stats.bytes, 2);
+
+	futils_lru_destroy(lru);
+	CU_ASSERT_EQUAL(s_released[1], 1);
+	CU_ASSERT_EQUAL(s_released[3], 2);
+}
+
+static void test_lru_bytes(void)
+{
+	struct futils_lru *lru;
+	struct futils_lru_stats stats;
+	int values[16];
+	int ret;
+
+	memset(s_released, 0, sizeof(s_released));
+
+	lru = futils_lru_new(0, 100, &test_release, s_released);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(lru);
+
+	ret = futils_lru_put(lru, 1, &values[1], 101);
+	CU_ASSERT_EQUAL(ret, -E2BIG);
+
+	ret = futils_lru_put(lru, 1, &values[1], 40);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_lru_put(lru, 2, &values[2], 40);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_lru_put(lru, 3, &values[3], 40);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[1], 1);
+
+	/* a large entry evicts several small ones */
+	ret = futils_lru_put(lru, 4, &values[4], 100);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[2], 1);
+	CU_ASSERT_EQUAL(s_released[3], 1);
+
+	ret = futils_lru_get_stats(lru, &stats);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(stats.evictions, 3);
+	CU_ASSERT_EQUAL(stats.entries, 1);
+	CU_ASSERT_EQUAL(stats.bytes, 100);
+
+	ret = futils_lru_clear(lru);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(s_released[4], 1);
+
+	futils_lru_destroy(lru);
+}
+
+CU_TestInfo s_lru_tests[] = {
+	{(char *)"entries", &test_lru_entries},
+	{(char *)"bytes", &test_lru_bytes},
+	CU_TEST_INFO_NULL,
+};
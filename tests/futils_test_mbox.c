@@ -33,7 +33,10 @@
 
 #ifdef _WIN32
 #  include <winsock2.h>
-#endif /* _WIN32 */
+#else /* !_WIN32 */
+#  include <poll.h>
+#  include <pthread.h>
+#endif /* !_WIN32 */
 
 struct message {
 	uint16_t u16;
@@ -171,7 +174,232 @@ static void test_mbox(void)
 #endif /* _WIN32 */
 }
 
+static void test_mbox_batch(void)
+{
+	struct mbox *box = NULL;
+	struct message msgs[200];
+	struct message out[300];
+	int ret, i, n, pushed;
+
+#ifdef _WIN32
+	/* Initialize winsock API */
+	WSADATA wsadata;
+	WSAStartup(MAKEWORD(2, 0), &wsadata);
+#endif /* _WIN32 */
+
+	for (i = 0; i < 200; i++) {
+		msgs[i] = s_msg1;
+		msgs[i].u32 = i;
+	}
+
+	box = mbox_new(sizeof(struct message));
+	CU_ASSERT_PTR_NOT_NULL_FATAL(box);
+
+	/* Invalid arguments */
+	ret = mbox_push_batch(NULL, msgs, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = mbox_push_batch(box, NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = mbox_push_batch(box, msgs, 0);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = mbox_peek_batch(NULL, out, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = mbox_peek_batch(box, NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = mbox_peek_batch(box, out, 0);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	/* Empty mbox */
+	ret = mbox_peek_batch(box, out, 300);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+
+	/* Push a batch, read it back in several parts */
+	ret = mbox_push_batch(box, msgs, 200);
+	CU_ASSERT_EQUAL(ret, 200);
+	ret = mbox_peek_batch(box, out, 50);
+	CU_ASSERT_EQUAL(ret, 50);
+	ret = memcmp(out, msgs, 50 * sizeof(struct message));
+	CU_ASSERT_EQUAL(ret, 0);
+	n = 50;
+	while (n < 200) {
+		ret = mbox_peek_batch(box, out, 300);
+		CU_ASSERT_FATAL(ret > 0 && ret <= 200 - n);
+		CU_ASSERT_EQUAL(memcmp(out, &msgs[n],
+				       ret * sizeof(struct message)), 0);
+		n += ret;
+	}
+	ret = mbox_peek_batch(box, out, 300);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+
+	/* Batches mixed with single messages */
+	ret = mbox_push(box, &s_msg2);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = mbox_push_batch(box, msgs, 3);
+	CU_ASSERT_EQUAL(ret, 3);
+	ret = mbox_peek(box, &out[0]);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = memcmp(&out[0], &s_msg2, sizeof(struct message));
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = mbox_peek_batch(box, out, 300);
+	CU_ASSERT_EQUAL(ret, 3);
+	ret = memcmp(out, msgs, 3 * sizeof(struct message));
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* Fill mbox, only whole messages must be queued */
+	pushed = 0;
+	while ((ret = mbox_push_batch(box, msgs, 200)) > 0)
+		pushed += ret;
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	CU_ASSERT(pushed > 0);
+	n = 0;
+	while ((ret = mbox_peek_batch(box, out, 300)) > 0) {
+		for (i = 0; i < ret; i++)
+			CU_ASSERT_EQUAL(out[i].u64, s_msg1.u64);
+		n += ret;
+	}
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	CU_ASSERT_EQUAL(n, pushed);
+
+	mbox_destroy(box);
+
+#ifdef _WIN32
+	/* Cleanup winsock API */
+	WSACleanup();
+#endif /* _WIN32 */
+}
+
+#ifndef _WIN32
+
+#define RING_MSG_SIZE 8192
+#define RING_CAPACITY 16
+
+static int fd_is_readable(int fd)
+{
+	struct pollfd pfd = {
+		.fd = fd,
+		.events = POLLIN,
+		.revents = 0,
+	};
+
+	return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+static void *ring_consumer(void *userdata)
+{
+	struct mbox *box = userdata;
+	uint8_t msg[RING_MSG_SIZE];
+	struct pollfd pfd = {
+		.fd = mbox_get_read_fd(box),
+		.events = POLLIN,
+		.revents = 0,
+	};
+	int i;
+
+	/* drain messages as a poll loop would do */
+	for (i = 0; i < 4 * RING_CAPACITY;) {
+		if (poll(&pfd, 1, 1000) != 1)
+			break;
+		while (mbox_peek(box, msg) == 0) {
+			if (msg[0] != (uint8_t)i || msg[RING_MSG_SIZE - 1] !=
+			    (uint8_t)i)
+				return NULL;
+			i++;
+		}
+	}
+
+	return (void *)(intptr_t)i;
+}
+
+static void test_mbox_ring(void)
+{
+	struct mbox *box = NULL;
+	static uint8_t msg[RING_MSG_SIZE];
+	static uint8_t out[RING_CAPACITY][RING_MSG_SIZE];
+	pthread_t thread;
+	void *thread_ret;
+	int ret, fd, i;
+
+	/* Invalid arguments */
+	box = mbox_new_ring(0, RING_CAPACITY);
+	CU_ASSERT_PTR_NULL(box);
+	box = mbox_new_ring(RING_MSG_SIZE, 0);
+	CU_ASSERT_PTR_NULL(box);
+
+	/* Messages larger than PIPE_BUF are allowed */
+	box = mbox_new_ring(RING_MSG_SIZE, RING_CAPACITY);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(box);
+	fd = mbox_get_read_fd(box);
+	CU_ASSERT(fd >= 0);
+
+	/* Empty ring */
+	ret = mbox_peek(box, out[0]);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	/* fd readable while messages are queued */
+	memset(msg, 1, sizeof(msg));
+	ret = mbox_push(box, msg);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_TRUE(fd_is_readable(fd));
+	memset(msg, 2, sizeof(msg));
+	ret = mbox_push(box, msg);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_TRUE(fd_is_readable(fd));
+
+	ret = mbox_peek(box, out[0]);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(out[0][0], 1);
+	CU_ASSERT_EQUAL(out[0][RING_MSG_SIZE - 1], 1);
+	CU_ASSERT_TRUE(fd_is_readable(fd));
+	ret = mbox_peek(box, out[0]);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(out[0][0], 2);
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	/* Fill ring, wrapping around */
+	for (i = 0; i < RING_CAPACITY; i++) {
+		memset(msg, i, sizeof(msg));
+		ret = mbox_push(box, msg);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = mbox_push(box, msg);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	ret = mbox_push_batch(box, msg, 1);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	ret = mbox_push_block(box, msg, 50);
+	CU_ASSERT_EQUAL(ret, -ETIMEDOUT);
+
+	/* Read all in one batch */
+	ret = mbox_peek_batch(box, out, RING_CAPACITY);
+	CU_ASSERT_EQUAL(ret, RING_CAPACITY);
+	for (i = 0; i < RING_CAPACITY; i++) {
+		CU_ASSERT_EQUAL(out[i][0], i);
+		CU_ASSERT_EQUAL(out[i][RING_MSG_SIZE - 1], i);
+	}
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	/* Blocking producer, polling consumer */
+	ret = pthread_create(&thread, NULL, &ring_consumer, box);
+	CU_ASSERT_EQUAL_FATAL(ret, 0);
+	for (i = 0; i < 4 * RING_CAPACITY; i++) {
+		memset(msg, i, sizeof(msg));
+		ret = mbox_push_block(box, msg, 0);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	pthread_join(thread, &thread_ret);
+	CU_ASSERT_EQUAL((intptr_t)thread_ret, 4 * RING_CAPACITY);
+	CU_ASSERT_FALSE(fd_is_readable(fd));
+
+	mbox_destroy(box);
+}
+
+#endif /* !_WIN32 */
+
 CU_TestInfo s_mbox_tests[] = {
 	{(char *)"mbox", &test_mbox},
+	{(char *)"mbox batch", &test_mbox_batch},
+#ifndef _WIN32
+	{(char *)"mbox ring", &test_mbox_ring},
+#endif /* !_WIN32 */
 	CU_TEST_INFO_NULL,
 };
@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_mpmc.c
+ *
+ * @brief mpmc unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#include <pthread.h>
+
+#define NB_TEST_THREADS 4
+#define NB_TEST_ELEMS_PER_THREAD 50000
+
+struct mpmc_test_elem {
+	uint32_t producer;
+	uint32_t value;
+};
+
+struct mpmc_test_consumer {
+	struct futils_mpmc *q;
+	uint64_t sum;
+	uint32_t count;
+	uint32_t last[NB_TEST_THREADS];
+	int errors;
+};
+
+static void test_mpmc_basic(void)
+{
+	struct futils_mpmc *q;
+	uint32_t i, value;
+	int ret;
+
+	q = futils_mpmc_new(0, 8);
+	CU_ASSERT_PTR_NULL(q);
+	q = futils_mpmc_new(sizeof(uint32_t), 0);
+	CU_ASSERT_PTR_NULL(q);
+	ret = futils_mpmc_try_push(NULL, &i);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_mpmc_try_pop(NULL, &value);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	/* size rounded up to a power of two */
+	q = futils_mpmc_new(sizeof(uint32_t), 5);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(q);
+	ret = futils_mpmc_try_push(q, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	ret = futils_mpmc_try_pop(q, &value);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	ret = futils_mpmc_pop_block(q, &value, 20);
+	CU_ASSERT_EQUAL(ret, -ETIMEDOUT);
+
+	for (i = 0; i < 8; i++) {
+		ret = futils_mpmc_try_push(q, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_mpmc_try_push(q, &i);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	ret = futils_mpmc_push_block(q, &i, 20);
+	CU_ASSERT_EQUAL(ret, -ETIMEDOUT);
+
+	/* wrap around several laps */
+	for (i = 0; i < 100; i++) {
+		ret = futils_mpmc_try_pop(q, &value);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL(value, i);
+		value = i + 8;
+		ret = futils_mpmc_push_block(q, &value, 0);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	for (i = 100; i < 108; i++) {
+		ret = futils_mpmc_pop_block(q, &value, 0);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL(value, i);
+	}
+	ret = futils_mpmc_try_pop(q, &value);
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+
+	futils_mpmc_destroy(q);
+}
+
+static void *mpmc_producer(void *userdata)
+{
+	struct futils_mpmc *q = userdata;
+	static uint32_t next_id;
+	struct mpmc_test_elem elem;
+	uint32_t i;
+
+	elem.producer = __atomic_fetch_add(&next_id, 1, __ATOMIC_RELAXED) %
+			NB_TEST_THREADS;
+	for (i = 1; i <= NB_TEST_ELEMS_PER_THREAD; i++) {
+		elem.value = i;
+		/* mix non blocking and blocking calls */
+		if (i % 2 == 0 && futils_mpmc_try_push(q, &elem) == 0)
+			continue;
+		if (futils_mpmc_push_block(q, &elem, 0) < 0)
+			break;
+	}
+
+	return NULL;
+}
+
+static void *mpmc_consumer(void *userdata)
+{
+	struct mpmc_test_consumer *c = userdata;
+	struct mpmc_test_elem elem;
+	uint32_t i;
+
+	for (i = 0; i < NB_TEST_ELEMS_PER_THREAD; i++) {
+		if (futils_mpmc_pop_block(c->q, &elem, 5000) < 0) {
+			c->errors++;
+			break;
+		}
+
+		/* each producer values are popped in order */
+		if (elem.producer >= NB_TEST_THREADS ||
+		    elem.value <= c->last[elem.producer]) {
+			c->errors++;
+			continue;
+		}
+		c->last[elem.producer] = elem.value;
+		c->sum += elem.value;
+		c->count++;
+	}
+
+	return NULL;
+}
+
+static void test_mpmc_threads(void)
+{
+	struct futils_mpmc *q;
+	struct mpmc_test_consumer consumers[NB_TEST_THREADS];
+	pthread_t producers_thread[NB_TEST_THREADS];
+	pthread_t consumers_thread[NB_TEST_THREADS];
+	uint64_t sum = 0;
+	uint32_t count = 0;
+	int i, ret;
+
+	q = futils_mpmc_new(sizeof(struct mpmc_test_elem), 64);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(q);
+
+	memset(consumers, 0, sizeof(consumers));
+	for (i = 0; i < NB_TEST_THREADS; i++) {
+		consumers[i].q = q;
+		ret = pthread_create(&consumers_thread[i], NULL,
+				     &mpmc_consumer, &consumers[i]);
+		CU_ASSERT_EQUAL_FATAL(ret, 0);
+	}
+	for (i = 0; i < NB_TEST_THREADS; i++) {
+		ret = pthread_create(&producers_thread[i], NULL,
+				     &mpmc_producer, q);
+		CU_ASSERT_EQUAL_FATAL(ret, 0);
+	}
+
+	for (i = 0; i < NB_TEST_THREADS; i++)
+		pthread_join(producers_thread[i], NULL);
+	for (i = 0; i < NB_TEST_THREADS; i++) {
+		pthread_join(consumers_thread[i], NULL);
+		CU_ASSERT_EQUAL(consumers[i].errors, 0);
+		sum += consumers[i].sum;
+		count += consumers[i].count;
+	}
+
+	/* every element popped exactly once */
+	CU_ASSERT_EQUAL(count, NB_TEST_THREADS * NB_TEST_ELEMS_PER_THREAD);
+	CU_ASSERT_EQUAL(sum, (uint64_t)NB_TEST_THREADS *
+			NB_TEST_ELEMS_PER_THREAD *
+			(NB_TEST_ELEMS_PER_THREAD + 1) / 2);
+
+	futils_mpmc_destroy(q);
+}
+
+CU_TestInfo s_mpmc_tests[] = {
+	{(char *)"basic", &test_mpmc_basic},
+	{(char *)"threads", &test_mpmc_threads},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_mpscq.c
+ *
+ * @brief mpscq unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#include <pthread.h>
+
+#define NB_TEST_PRODUCERS 4
+#define NB_TEST_ITEMS 100000
+
+struct mpscq_test_item {
+	struct futils_mpscq_node node;
+	int producer;
+	int seq;
+};
+
+struct mpscq_test_producer {
+	struct futils_mpscq *q;
+	struct mpscq_test_item *items;
+	int id;
+	pthread_t thread;
+};
+
+static void test_mpscq_basic(void)
+{
+	struct futils_mpscq q;
+	struct mpscq_test_item items[10];
+	struct mpscq_test_item *item;
+	struct futils_mpscq_node *node;
+	int i;
+
+	futils_mpscq_init(&q);
+	CU_ASSERT_TRUE(futils_mpscq_is_empty(&q));
+	CU_ASSERT_PTR_NULL(futils_mpscq_pop(&q));
+
+	for (i = 0; i < 10; i++) {
+		items[i].seq = i;
+		futils_mpscq_push(&q, &items[i].node);
+	}
+	CU_ASSERT_FALSE(futils_mpscq_is_empty(&q));
+
+	/* nodes are popped in push order */
+	for (i = 0; i < 10; i++) {
+		node = futils_mpscq_pop(&q);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(node);
+		item = futils_mpscq_entry(node, struct mpscq_test_item, node);
+		CU_ASSERT_EQUAL(item->seq, i);
+	}
+	CU_ASSERT_PTR_NULL(futils_mpscq_pop(&q));
+	CU_ASSERT_TRUE(futils_mpscq_is_empty(&q));
+
+	/* queue can be reused, including its last popped node */
+	futils_mpscq_push(&q, &items[9].node);
+	node = futils_mpscq_pop(&q);
+	CU_ASSERT_PTR_EQUAL(node, &items[9].node);
+	CU_ASSERT_PTR_NULL(futils_mpscq_pop(&q));
+}
+
+static void *mpscq_test_producer_thread(void *arg)
+{
+	struct mpscq_test_producer *producer = arg;
+	int i;
+
+	for (i = 0; i < NB_TEST_ITEMS; i++) {
+		producer->items[i].producer = producer->id;
+		producer->items[i].seq = i;
+		futils_mpscq_push(producer->q, &producer->items[i].node);
+	}
+	return NULL;
+}
+
+static void test_mpscq_concurrent(void)
+{
+	struct futils_mpscq q;
+	struct mpscq_test_producer producers[NB_TEST_PRODUCERS];
+	int next_seq[NB_TEST_PRODUCERS];
+	struct mpscq_test_item *item;
+	struct futils_mpscq_node *node;
+	int i, ret, count = 0, errors = 0;
+
+	futils_mpscq_init(&q);
+	for (i = 0; i < NB_TEST_PRODUCERS; i++) {
+		producers[i].q = &q;
+		producers[i].id = i;
+		producers[i].items = calloc(NB_TEST_ITEMS,
+					    sizeof(*producers[i].items));
+		CU_ASSERT_PTR_NOT_NULL_FATAL(producers[i].items);
+		next_seq[i] = 0;
+	}
+
+	for (i = 0; i < NB_TEST_PRODUCERS; i++) {
+		ret = pthread_create(&producers[i].thread, NULL,
+				     &mpscq_test_producer_thread,
+				     &producers[i]);
+		CU_ASSERT_EQUAL_FATAL(ret, 0);
+	}
+
+	/* items of each producer are received in order */
+	while (count < NB_TEST_PRODUCERS * NB_TEST_ITEMS) {
+		node = futils_mpscq_pop(&q);
+		if (!node)
+			continue;
+		item = futils_mpscq_entry(node, struct mpscq_test_item, node);
+		if (item->seq != next_seq[item->producer])
+			errors++;
+		next_seq[item->producer] = item->seq + 1;
+		count++;
+	}
+
+	for (i = 0; i < NB_TEST_PRODUCERS; i++) {
+		pthread_join(producers[i].thread, NULL);
+		free(producers[i].items);
+	}
+
+	CU_ASSERT_EQUAL(errors, 0);
+	CU_ASSERT_PTR_NULL(futils_mpscq_pop(&q));
+}
+
+CU_TestInfo s_mpscq_tests[] = {
+	{(char *)"basic", &test_mpscq_basic},
+	{(char *)"concurrent", &test_mpscq_concurrent},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_phash.c
+ *
+ * @brief phash unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_KEYS 10000
+
+static void test_phash_invalid(void)
+{
+	struct futils_phash phash;
+	struct hash hash;
+	struct hash_entry entry;
+	void *data;
+	int ret;
+
+	ret = futils_phash_build(NULL, NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_phash_lookup(NULL, 1, &data);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_phash_destroy(NULL);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	/* empty table */
+	ret = futils_hash_init(&hash, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_phash_build(&phash, &hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_phash_lookup(&phash, 1, &data);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	ret = futils_phash_destroy(&phash);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* intrusive entries are rejected */
+	ret = futils_hash_insert(&hash, 1, &hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_hash_link(&hash, 2, &entry);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_phash_build(&phash, &hash);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	CU_ASSERT_EQUAL(phash.count, 0);
+	ret = futils_hash_unlink(&hash, &entry);
+	CU_ASSERT_EQUAL(ret, 0);
+	futils_hash_destroy(&hash);
+}
+
+static void test_phash_const(void)
+{
+	static const char *const names[] = {"zero", "one", "two", "three"};
+	struct futils_phash phash;
+	struct hash hash;
+	const void *cdata;
+	void *data;
+	uint32_t i;
+	int ret;
+
+	ret = futils_hash_init(&hash, 0, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	for (i = 0; i < 4; i++) {
+		ret = futils_hash_insert_const(&hash, i * 100, names[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_hash_insert(&hash, 1000, &hash);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	ret = futils_phash_build(&phash, &hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(phash.count, 5);
+
+	/* source table is not needed anymore */
+	futils_hash_destroy(&hash);
+
+	for (i = 0; i < 4; i++) {
+		ret = futils_phash_lookup_const(&phash, i * 100, &cdata);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_PTR_EQUAL(cdata, names[i]);
+		ret = futils_phash_lookup(&phash, i * 100, &data);
+		CU_ASSERT_EQUAL(ret, -EPERM);
+	}
+
+	ret = futils_phash_lookup(&phash, 1000, &data);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(data, &hash);
+	ret = futils_phash_lookup(&phash, 1, &data);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	futils_phash_destroy(&phash);
+}
+
+static void test_phash_many(void)
+{
+	struct futils_phash phash;
+	struct hash hash;
+	const void *data;
+	uint32_t i, key;
+	int ret;
+
+	ret = futils_hash_init(&hash, NB_TEST_KEYS, NULL);
+	CU_ASSERT_EQUAL(ret, 0);
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		key = i * 7919;
+		ret = futils_hash_insert_const(&hash, key,
+					       (const void *)(uintptr_t)(i + 1));
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	ret = futils_phash_build(&phash, &hash);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(phash.count, NB_TEST_KEYS);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		ret = futils_phash_lookup_const(&phash, i * 7919, &data);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_EQUAL((uintptr_t)data, i + 1);
+		ret = futils_phash_lookup_const(&phash, i * 7919 + 1, &data);
+		CU_ASSERT_EQUAL(ret, -ENOENT);
+	}
+
+	futils_phash_destroy(&phash);
+	futils_hash_destroy(&hash);
+}
+
+CU_TestInfo s_phash_tests[] = {
+	{(char *)"invalid", &test_phash_invalid},
+	{(char *)"const", &test_phash_const},
+	{(char *)"many", &test_phash_many},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_rbtree.c
+ *
+ * @brief rbtree unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_NODES 2000
+
+struct rbtree_test_item {
+	struct futils_rbnode node;
+	uint32_t key;
+	uint32_t seq;
+	int in_tree;
+};
+
+static struct rbtree_test_item s_items[NB_TEST_NODES];
+
+static int rbtree_test_cmp(const struct futils_rbnode *a,
+			   const struct futils_rbnode *b)
+{
+	const struct rbtree_test_item *ia = futils_rbtree_entry(a,
+			struct rbtree_test_item, node);
+	const struct rbtree_test_item *ib = futils_rbtree_entry(b,
+			struct rbtree_test_item, node);
+
+	return ia->key < ib->key ? -1 : ia->key > ib->key;
+}
+
+static int rbtree_test_key_cmp(const struct futils_rbnode *node,
+			       const void *key)
+{
+	const struct rbtree_test_item *item = futils_rbtree_entry(node,
+			struct rbtree_test_item, node);
+	uint32_t k = *(const uint32_t *)key;
+
+	return item->key < k ? -1 : item->key > k;
+}
+
+/* check red-black properties, return black height or -1 */
+static int rbtree_test_check(const struct futils_rbnode *node,
+			     const struct futils_rbnode *parent)
+{
+	int lh, rh;
+
+	if (!node)
+		return 1;
+	if (node->parent != parent)
+		return -1;
+	if (node->red && ((node->left && node->left->red) ||
+			  (node->right && node->right->red)))
+		return -1;
+
+	lh = rbtree_test_check(node->left, node);
+	rh = rbtree_test_check(node->right, node);
+	if (lh < 0 || rh < 0 || lh != rh)
+		return -1;
+
+	return lh + (node->red ? 0 : 1);
+}
+
+/* check tree order and count nodes */
+static int rbtree_test_walk(const struct futils_rbtree *tree)
+{
+	const struct rbtree_test_item *item, *prev = NULL;
+	struct futils_rbnode *node;
+	int count = 0;
+
+	futils_rbtree_walk_forward(tree, node) {
+		item = futils_rbtree_entry(node, struct rbtree_test_item, node);
+		if (prev) {
+			CU_ASSERT(prev->key <= item->key);
+			/* equal keys are kept in insertion order */
+			if (prev->key == item->key)
+				CU_ASSERT(prev->seq < item->seq);
+			CU_ASSERT_PTR_EQUAL(futils_rbtree_prev(node),
+					    &prev->node);
+		}
+		prev = item;
+		count++;
+	}
+	if (prev)
+		CU_ASSERT_PTR_EQUAL(futils_rbtree_last(tree), &prev->node);
+
+	return count;
+}
+
+static void test_rbtree_basic(void)
+{
+	struct futils_rbtree tree;
+	struct futils_rbnode *node, *tmp;
+	struct rbtree_test_item *item;
+	uint32_t i, key;
+
+	futils_rbtree_init(&tree);
+	CU_ASSERT_TRUE(futils_rbtree_is_empty(&tree));
+	CU_ASSERT_PTR_NULL(futils_rbtree_first(&tree));
+	CU_ASSERT_PTR_NULL(futils_rbtree_last(&tree));
+	key = 1;
+	CU_ASSERT_PTR_NULL(futils_rbtree_lower_bound(&tree,
+			&rbtree_test_key_cmp, &key));
+
+	/* keys 0, 10, 20 ... inserted in decreasing order */
+	for (i = 0; i < 100; i++) {
+		s_items[i].key = (99 - i) * 10;
+		s_items[i].seq = i;
+		futils_rbtree_insert(&tree, &s_items[i].node,
+				     &rbtree_test_cmp);
+	}
+	CU_ASSERT_FALSE(futils_rbtree_is_empty(&tree));
+	CU_ASSERT_EQUAL(rbtree_test_walk(&tree), 100);
+	CU_ASSERT(rbtree_test_check(tree.root, NULL) > 0);
+
+	key = 15;
+	node = futils_rbtree_lower_bound(&tree, &rbtree_test_key_cmp, &key);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(node);
+	item = futils_rbtree_entry(node, struct rbtree_test_item, node);
+	CU_ASSERT_EQUAL(item->key, 20);
+	CU_ASSERT_PTR_NULL(futils_rbtree_find(&tree, &rbtree_test_key_cmp,
+					      &key));
+	key = 20;
+	CU_ASSERT_PTR_EQUAL(futils_rbtree_find(&tree, &rbtree_test_key_cmp,
+					       &key), node);
+	key = 991;
+	CU_ASSERT_PTR_NULL(futils_rbtree_lower_bound(&tree,
+			&rbtree_test_key_cmp, &key));
+
+	/* remove every node while walking */
+	futils_rbtree_walk_forward_safe(&tree, node, tmp)
+		futils_rbtree_erase(&tree, node);
+	CU_ASSERT_TRUE(futils_rbtree_is_empty(&tree));
+}
+
+static void test_rbtree_random(void)
+{
+	struct futils_rbtree tree;
+	struct rbtree_test_item *item;
+	uint32_t i, idx, seq = 0, rnd = 1;
+	int count = 0, round;
+
+	futils_rbtree_init(&tree);
+	memset(s_items, 0, sizeof(s_items));
+
+	for (round = 0; round < 20000; round++) {
+		rnd = rnd * 1103515245 + 12345;
+		idx = (rnd >> 8) % NB_TEST_NODES;
+		item = &s_items[idx];
+		if (item->in_tree) {
+			futils_rbtree_erase(&tree, &item->node);
+			item->in_tree = 0;
+			count--;
+		} else {
+			/* small key range to get duplicates */
+			item->key = (rnd >> 20) % 500;
+			item->seq = seq++;
+			futils_rbtree_insert(&tree, &item->node,
+					     &rbtree_test_cmp);
+			item->in_tree = 1;
+			count++;
+		}
+
+		if (round % 1000 == 0) {
+			CU_ASSERT(rbtree_test_check(tree.root, NULL) > 0);
+			CU_ASSERT_EQUAL(rbtree_test_walk(&tree), count);
+		}
+	}
+
+	CU_ASSERT(rbtree_test_check(tree.root, NULL) > 0);
+	CU_ASSERT_EQUAL(rbtree_test_walk(&tree), count);
+
+	for (i = 0; i < NB_TEST_NODES; i++) {
+		if (s_items[i].in_tree) {
+			futils_rbtree_erase(&tree, &s_items[i].node);
+			CU_ASSERT(tree.root == NULL ||
+				  rbtree_test_check(tree.root, NULL) > 0);
+		}
+	}
+	CU_ASSERT_TRUE(futils_rbtree_is_empty(&tree));
+}
+
+CU_TestInfo s_rbtree_tests[] = {
+	{(char *)"basic", &test_rbtree_basic},
+	{(char *)"random", &test_rbtree_random},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_slotmap.c
+ *
+ * @brief slotmap unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_ELEMS 1000
+
+struct slotmap_test_elem {
+	uint32_t value;
+	uint32_t pad[3];
+};
+
+static void test_slotmap_basic(void)
+{
+	struct futils_slotmap *map;
+	struct slotmap_test_elem elem, *p;
+	uint64_t handle, handle2;
+	int ret;
+
+	map = futils_slotmap_new(0, 0);
+	CU_ASSERT_PTR_NULL(map);
+	ret = futils_slotmap_insert(NULL, NULL, &handle);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_slotmap_remove(NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	CU_ASSERT_PTR_NULL(futils_slotmap_get(NULL, 1));
+
+	map = futils_slotmap_new(sizeof(elem), 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(map);
+	CU_ASSERT_EQUAL(futils_slotmap_count(map), 0);
+	CU_ASSERT_PTR_NULL(futils_slotmap_data(map));
+	CU_ASSERT_PTR_NULL(futils_slotmap_get(map,
+			FUTILS_SLOTMAP_INVALID_HANDLE));
+
+	memset(&elem, 0, sizeof(elem));
+	elem.value = 42;
+	ret = futils_slotmap_insert(map, &elem, &handle);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_NOT_EQUAL(handle, FUTILS_SLOTMAP_INVALID_HANDLE);
+	p = futils_slotmap_get(map, handle);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(p);
+	CU_ASSERT_EQUAL(p->value, 42);
+	CU_ASSERT_PTR_EQUAL(futils_slotmap_data(map), p);
+	CU_ASSERT_EQUAL(futils_slotmap_handle_at(map, 0), handle);
+	CU_ASSERT_EQUAL(futils_slotmap_handle_at(map, 1),
+			FUTILS_SLOTMAP_INVALID_HANDLE);
+
+	ret = futils_slotmap_remove(map, handle);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_slotmap_remove(map, handle);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+	CU_ASSERT_PTR_NULL(futils_slotmap_get(map, handle));
+
+	/* slot is reused, but old handle stays stale */
+	ret = futils_slotmap_insert(map, NULL, &handle2);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_NOT_EQUAL(handle, handle2);
+	CU_ASSERT_PTR_NULL(futils_slotmap_get(map, handle));
+	p = futils_slotmap_get(map, handle2);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(p);
+	CU_ASSERT_EQUAL(p->value, 0);
+
+	futils_slotmap_destroy(map);
+}
+
+static void test_slotmap_many(void)
+{
+	static uint64_t handles[NB_TEST_ELEMS];
+	struct futils_slotmap *map;
+	struct slotmap_test_elem elem, *p, *data;
+	uint32_t i, sum, expected;
+	size_t n;
+	int ret;
+
+	map = futils_slotmap_new(sizeof(elem), 4);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(map);
+
+	memset(&elem, 0, sizeof(elem));
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		elem.value = i;
+		ret = futils_slotmap_insert(map, &elem, &handles[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(futils_slotmap_count(map), NB_TEST_ELEMS);
+
+	/* remove odd values */
+	for (i = 1; i < NB_TEST_ELEMS; i += 2) {
+		ret = futils_slotmap_remove(map, handles[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(futils_slotmap_count(map), NB_TEST_ELEMS / 2);
+
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		p = futils_slotmap_get(map, handles[i]);
+		if (i % 2) {
+			CU_ASSERT_PTR_NULL(p);
+		} else {
+			CU_ASSERT_PTR_NOT_NULL(p);
+			if (p)
+				CU_ASSERT_EQUAL(p->value, i);
+		}
+	}
+
+	/* dense iteration, and handles of dense elements */
+	data = futils_slotmap_data(map);
+	sum = 0;
+	expected = 0;
+	for (n = 0; n < futils_slotmap_count(map); n++) {
+		sum += data[n].value;
+		p = futils_slotmap_get(map, futils_slotmap_handle_at(map, n));
+		CU_ASSERT_PTR_EQUAL(p, &data[n]);
+	}
+	for (i = 0; i < NB_TEST_ELEMS; i += 2)
+		expected += i;
+	CU_ASSERT_EQUAL(sum, expected);
+
+	ret = futils_slotmap_clear(map);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(futils_slotmap_count(map), 0);
+	for (i = 0; i < NB_TEST_ELEMS; i++)
+		CU_ASSERT_PTR_NULL(futils_slotmap_get(map, handles[i]));
+
+	futils_slotmap_destroy(map);
+}
+
+CU_TestInfo s_slotmap_tests[] = {
+	{(char *)"basic", &test_slotmap_basic},
+	{(char *)"many", &test_slotmap_many},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,246 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_spsc.c
+ *
+ * @brief spsc unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define NB_TEST_RECORDS 100000
+
+struct spsc_test_ctx {
+	struct futils_spsc *spsc;
+	int variable;
+	int errors;
+};
+
+static size_t spsc_test_len(uint32_t i)
+{
+	return sizeof(uint32_t) + (i * 7) % 100;
+}
+
+static void test_spsc_fixed(void)
+{
+	struct futils_spsc *spsc;
+	uint32_t i, value;
+	ssize_t len;
+	int ret;
+
+	spsc = futils_spsc_new(0, sizeof(uint32_t), 0);
+	CU_ASSERT_PTR_NULL(spsc);
+	ret = futils_spsc_push(NULL, &i, sizeof(i));
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	len = futils_spsc_pop(NULL, &value, sizeof(value));
+	CU_ASSERT_EQUAL(len, -EINVAL);
+
+	/* size rounded up to a power of two */
+	spsc = futils_spsc_new(6, sizeof(uint32_t), 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(spsc);
+	CU_ASSERT_EQUAL(futils_spsc_get_max_size(spsc), sizeof(uint32_t));
+	CU_ASSERT_EQUAL(futils_spsc_get_fd(spsc), -1);
+	ret = futils_spsc_prepare_wait(spsc);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	CU_ASSERT_TRUE(futils_spsc_is_empty(spsc));
+
+	len = futils_spsc_pop(spsc, &value, sizeof(value));
+	CU_ASSERT_EQUAL(len, -EAGAIN);
+	ret = futils_spsc_push(spsc, &i, 2);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	for (i = 0; i < 8; i++) {
+		ret = futils_spsc_push(spsc, &i, sizeof(i));
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_spsc_push(spsc, &i, sizeof(i));
+	CU_ASSERT_EQUAL(ret, -EAGAIN);
+	CU_ASSERT_FALSE(futils_spsc_is_empty(spsc));
+
+	len = futils_spsc_pop(spsc, &value, 2);
+	CU_ASSERT_EQUAL(len, -ENOBUFS);
+
+	/* wrap around several times */
+	for (i = 0; i < 100; i++) {
+		len = futils_spsc_pop(spsc, &value, sizeof(value));
+		CU_ASSERT_EQUAL(len, sizeof(value));
+		CU_ASSERT_EQUAL(value, i);
+		value = i + 8;
+		ret = futils_spsc_push(spsc, &value, sizeof(value));
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	futils_spsc_destroy(spsc);
+}
+
+static void test_spsc_variable(void)
+{
+	struct futils_spsc *spsc;
+	uint8_t buf[128], out[128];
+	ssize_t max, len;
+	uint32_t i, j;
+	int ret, count;
+
+	spsc = futils_spsc_new(200, 0, 0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(spsc);
+	max = futils_spsc_get_max_size(spsc);
+	CU_ASSERT_EQUAL(max, 256 / 2 - sizeof(uint32_t));
+	ret = futils_spsc_push(spsc, buf, max + 1);
+	CU_ASSERT_EQUAL(ret, -EMSGSIZE);
+
+	/* empty records are allowed */
+	ret = futils_spsc_push(spsc, NULL, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	len = futils_spsc_pop(spsc, out, sizeof(out));
+	CU_ASSERT_EQUAL(len, 0);
+
+	/* largest record always fits in an empty ring */
+	for (i = 0; i < 20; i++) {
+		memset(buf, i, max);
+		ret = futils_spsc_push(spsc, buf, max);
+		CU_ASSERT_EQUAL(ret, 0);
+		len = futils_spsc_pop(spsc, out, 10);
+		CU_ASSERT_EQUAL(len, -ENOBUFS);
+		len = futils_spsc_pop(spsc, out, sizeof(out));
+		CU_ASSERT_EQUAL(len, max);
+		CU_ASSERT_EQUAL(memcmp(buf, out, max), 0);
+	}
+
+	/* fill and drain with different sizes, wrapping around */
+	for (j = 0, i = 0; j < 50; j++) {
+		count = 0;
+		for (;;) {
+			memset(buf, i + count, sizeof(buf));
+			ret = futils_spsc_push(spsc, buf,
+					       (i + count) % 40 + 1);
+			if (ret < 0)
+				break;
+			count++;
+		}
+		CU_ASSERT_EQUAL(ret, -EAGAIN);
+		CU_ASSERT(count > 0);
+		while (count-- > 0) {
+			len = futils_spsc_pop(spsc, out, sizeof(out));
+			CU_ASSERT_EQUAL(len, i % 40 + 1);
+			CU_ASSERT_EQUAL(out[0], (uint8_t)i);
+			CU_ASSERT_EQUAL(out[len - 1], (uint8_t)i);
+			i++;
+		}
+		CU_ASSERT_TRUE(futils_spsc_is_empty(spsc));
+	}
+
+	futils_spsc_destroy(spsc);
+}
+
+static void *spsc_consumer(void *userdata)
+{
+	struct spsc_test_ctx *ctx = userdata;
+	struct pollfd pfd = {
+		.fd = futils_spsc_get_fd(ctx->spsc),
+		.events = POLLIN,
+		.revents = 0,
+	};
+	uint8_t buf[128];
+	uint32_t i = 0, value;
+	ssize_t len;
+
+	while (i < NB_TEST_RECORDS) {
+		len = futils_spsc_pop(ctx->spsc, buf, sizeof(buf));
+		if (len == -EAGAIN) {
+			/* park then sleep until notified */
+			if (futils_spsc_prepare_wait(ctx->spsc) == 0 &&
+			    poll(&pfd, 1, 5000) != 1) {
+				ctx->errors++;
+				break;
+			}
+			continue;
+		}
+
+		memcpy(&value, buf, sizeof(value));
+		if (value != i || (ctx->variable &&
+				   (size_t)len != spsc_test_len(i)))
+			ctx->errors++;
+		i++;
+	}
+
+	return NULL;
+}
+
+static void spsc_test_threads(int variable)
+{
+	struct spsc_test_ctx ctx;
+	pthread_t thread;
+	uint8_t buf[128];
+	uint32_t i;
+	size_t len;
+	int ret;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.variable = variable;
+	ctx.spsc = futils_spsc_new(variable ? 1024 : 64,
+				   variable ? 0 : sizeof(uint32_t),
+				   FUTILS_SPSC_FLAG_NOTIFY);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(ctx.spsc);
+	CU_ASSERT(futils_spsc_get_fd(ctx.spsc) >= 0);
+
+	ret = pthread_create(&thread, NULL, &spsc_consumer, &ctx);
+	CU_ASSERT_EQUAL_FATAL(ret, 0);
+
+	memset(buf, 0, sizeof(buf));
+	for (i = 0; i < NB_TEST_RECORDS; i++) {
+		memcpy(buf, &i, sizeof(i));
+		len = variable ? spsc_test_len(i) : sizeof(uint32_t);
+		while ((ret = futils_spsc_push(ctx.spsc, buf, len)) == -EAGAIN)
+			sched_yield();
+		CU_ASSERT_EQUAL(ret, 0);
+		/* let the consumer park from time to time */
+		if (i % 10000 == 0)
+			usleep(1000);
+	}
+
+	pthread_join(thread, NULL);
+	CU_ASSERT_EQUAL(ctx.errors, 0);
+	CU_ASSERT_TRUE(futils_spsc_is_empty(ctx.spsc));
+
+	futils_spsc_destroy(ctx.spsc);
+}
+
+static void test_spsc_threads(void)
+{
+	spsc_test_threads(0);
+	spsc_test_threads(1);
+}
+
+CU_TestInfo s_spsc_tests[] = {
+	{(char *)"fixed", &test_spsc_fixed},
+	{(char *)"variable", &test_spsc_variable},
+	{(char *)"threads", &test_spsc_threads},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_strhash.c
+ *
+ * @brief strhash unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_KEYS 2000
+
+static void test_hash_bytes(void)
+{
+	static const char str[] = "The quick brown fox jumps over the lazy dog";
+	char buf[sizeof(str)];
+	uint64_t h1, h2;
+	size_t len;
+
+	/* same bytes give same hash regardless of alignment and seed is
+	 * taken into account, for every code path length */
+	for (len = 0; len < sizeof(str); len++) {
+		memcpy(buf + 1, str, len);
+		h1 = futils_hash_bytes(str, len, 0);
+		h2 = futils_hash_bytes(buf + 1, len, 0);
+		CU_ASSERT_EQUAL(h1, h2);
+		h2 = futils_hash_bytes(str, len, 1);
+		CU_ASSERT_NOT_EQUAL(h1, h2);
+		if (len > 0) {
+			h2 = futils_hash_bytes(str, len - 1, 0);
+			CU_ASSERT_NOT_EQUAL(h1, h2);
+		}
+	}
+}
+
+static void test_strhash_keys(int flags)
+{
+	struct futils_strhash hash;
+	static int values[NB_TEST_KEYS];
+	static const int cvalue = 1;
+	char key[64];
+	const void *cdata;
+	void *data;
+	int i, ret;
+
+	ret = futils_strhash_init(&hash, 0, flags, NULL);
+	CU_ASSERT_EQUAL_FATAL(ret, 0);
+
+	/* keys of varying length, including some not fitting arena chunks */
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		snprintf(key, sizeof(key), "/path/to/%0*d", i % 50, i);
+		ret = futils_strhash_insert(&hash, key, strlen(key),
+					    &values[i]);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	ret = futils_strhash_insert(&hash, "/path/to/0", 10, NULL);
+	CU_ASSERT_EQUAL(ret, -EEXIST);
+	CU_ASSERT_EQUAL(hash.count, NB_TEST_KEYS);
+
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		snprintf(key, sizeof(key), "/path/to/%0*d", i % 50, i);
+		ret = futils_strhash_lookup(&hash, key, strlen(key), &data);
+		CU_ASSERT_EQUAL(ret, 0);
+		CU_ASSERT_PTR_EQUAL(data, &values[i]);
+	}
+
+	/* prefix of a key is a different key */
+	ret = futils_strhash_lookup(&hash, "/path/to/", 9, &data);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	/* binary keys and empty key */
+	ret = futils_strhash_insert_const(&hash, "\0\1\0", 3, &cvalue);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_strhash_lookup(&hash, "\0\1\0", 3, &data);
+	CU_ASSERT_EQUAL(ret, -EPERM);
+	ret = futils_strhash_lookup_const(&hash, "\0\1\0", 3, &cdata);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(cdata, &cvalue);
+	ret = futils_strhash_insert(&hash, NULL, 0, &values[0]);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_strhash_lookup(&hash, "", 0, &data);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(data, &values[0]);
+
+	for (i = 0; i < NB_TEST_KEYS; i += 2) {
+		snprintf(key, sizeof(key), "/path/to/%0*d", i % 50, i);
+		ret = futils_strhash_remove(&hash, key, strlen(key));
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	for (i = 0; i < NB_TEST_KEYS; i++) {
+		snprintf(key, sizeof(key), "/path/to/%0*d", i % 50, i);
+		ret = futils_strhash_lookup(&hash, key, strlen(key), &data);
+		CU_ASSERT_EQUAL(ret, (i % 2 == 0) ? -ENOENT : 0);
+	}
+
+	futils_strhash_destroy(&hash);
+}
+
+static void test_strhash(void)
+{
+	test_strhash_keys(0);
+}
+
+static void test_strhash_arena(void)
+{
+	test_strhash_keys(FUTILS_STRHASH_ARENA);
+}
+
+CU_TestInfo s_strhash_tests[] = {
+	{(char *)"hash_bytes", &test_hash_bytes},
+	{(char *)"strhash", &test_strhash},
+	{(char *)"strhash_arena", &test_strhash_arena},
+	CU_TEST_INFO_NULL,
+};
@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_timerwheel.c
+ *
+ * @brief timerwheel unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_TIMERS 1000
+
+struct timerwheel_test_timer {
+	struct futils_timer timer;
+	uint64_t expire_ms;
+	uint64_t fired_ms;
+	int fired;
+};
+
+static uint64_t s_now_ms;
+
+static void timerwheel_test_cb(struct futils_timer *timer, void *userdata)
+{
+	struct timerwheel_test_timer *t = FUTILS_CONTAINER_OF(timer,
+			struct timerwheel_test_timer, timer);
+
+	CU_ASSERT_PTR_EQUAL(userdata, t);
+	CU_ASSERT_FALSE(futils_timer_is_armed(timer));
+	t->fired++;
+	t->fired_ms = s_now_ms;
+}
+
+static void test_timerwheel_basic(void)
+{
+	struct futils_timerwheel wheel;
+	struct timerwheel_test_timer t;
+	uint64_t expire_ms;
+	int ret;
+
+	ret = futils_timerwheel_init(NULL, 1);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_timerwheel_init(&wheel, 0);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	ret = futils_timerwheel_init(&wheel, 10);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(futils_timerwheel_get_timeout(&wheel), -1);
+	ret = futils_timerwheel_next_expiry(&wheel, &expire_ms);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	memset(&t, 0, sizeof(t));
+	futils_timer_init(&t.timer, &timerwheel_test_cb, &t);
+	CU_ASSERT_FALSE(futils_timer_is_armed(&t.timer));
+
+	/* relative timeout, with monotonic clock */
+	ret = futils_timerwheel_arm(&wheel, &t.timer, 1000);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_TRUE(futils_timer_is_armed(&t.timer));
+	ret = futils_timerwheel_get_timeout(&wheel);
+	CU_ASSERT(ret > 0 && ret <= 1010);
+	ret = futils_timerwheel_advance(&wheel);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	ret = futils_timerwheel_cancel(&wheel, &t.timer);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_FALSE(futils_timer_is_armed(&t.timer));
+	CU_ASSERT_EQUAL(wheel.count, 0);
+	ret = futils_timerwheel_cancel(&wheel, &t.timer);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(futils_timerwheel_get_timeout(&wheel), -1);
+
+	/* already expired timer fires on next advance */
+	ret = futils_timerwheel_arm(&wheel, &t.timer, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_timerwheel_next_expiry(&wheel, &expire_ms);
+	CU_ASSERT_EQUAL(ret, 0);
+	s_now_ms = expire_ms;
+	ret = futils_timerwheel_advance_to(&wheel, expire_ms);
+	CU_ASSERT_EQUAL(ret, 1);
+	CU_ASSERT_EQUAL(t.fired, 1);
+}
+
+static void test_timerwheel_many(void)
+{
+	static struct timerwheel_test_timer timers[NB_TEST_TIMERS];
+	struct futils_timerwheel wheel;
+	uint64_t start_ms, end_ms, expire_ms;
+	uint32_t i, rnd = 1;
+	int ret, fired = 0;
+
+	ret = futils_timerwheel_init(&wheel, 1);
+	CU_ASSERT_EQUAL_FATAL(ret, 0);
+	start_ms = wheel.now;
+
+	/* timeouts from 1 ms to about 12 days, to use several levels */
+	for (i = 0; i < NB_TEST_TIMERS; i++) {
+		rnd = rnd * 1103515245 + 12345;
+		memset(&timers[i], 0, sizeof(timers[i]));
+		futils_timer_init(&timers[i].timer, &timerwheel_test_cb,
+				  &timers[i]);
+		timers[i].expire_ms = start_ms + 1 +
+				      ((uint64_t)rnd << (i % 30)) % (1u << 30);
+		ret = futils_timerwheel_arm_at(&wheel, &timers[i].timer,
+					       timers[i].expire_ms);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(wheel.count, NB_TEST_TIMERS);
+
+	/* cancel a few timers */
+	for (i = 0; i < NB_TEST_TIMERS; i += 10) {
+		ret = futils_timerwheel_cancel(&wheel, &timers[i].timer);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+
+	/* advance from event to event, timers must fire exactly on time */
+	end_ms = start_ms + (1u << 30) + 1;
+	while (futils_timerwheel_next_expiry(&wheel, &expire_ms) == 0) {
+		CU_ASSERT_FATAL(expire_ms <= end_ms);
+		s_now_ms = expire_ms;
+		ret = futils_timerwheel_advance_to(&wheel, expire_ms);
+		CU_ASSERT(ret >= 0);
+		fired += ret;
+	}
+
+	CU_ASSERT_EQUAL(fired, NB_TEST_TIMERS - NB_TEST_TIMERS / 10);
+	CU_ASSERT_EQUAL(wheel.count, 0);
+	for (i = 0; i < NB_TEST_TIMERS; i++) {
+		if (i % 10 == 0) {
+			CU_ASSERT_EQUAL(timers[i].fired, 0);
+		} else {
+			CU_ASSERT_EQUAL(timers[i].fired, 1);
+			CU_ASSERT_EQUAL(timers[i].fired_ms,
+					timers[i].expire_ms);
+		}
+	}
+
+	/* a large jump fires everything at once */
+	for (i = 0; i < NB_TEST_TIMERS; i++) {
+		ret = futils_timerwheel_arm_at(&wheel, &timers[i].timer,
+					       end_ms + i * 1000);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	s_now_ms = end_ms + NB_TEST_TIMERS * 1000;
+	ret = futils_timerwheel_advance_to(&wheel, s_now_ms);
+	CU_ASSERT_EQUAL(ret, NB_TEST_TIMERS);
+	CU_ASSERT_EQUAL(wheel.count, 0);
+}
+
+CU_TestInfo s_timerwheel_tests[] = {
+	{(char *)"basic", &test_timerwheel_basic},
+	{(char *)"many", &test_timerwheel_many},
+	CU_TEST_INFO_NULL,
+};
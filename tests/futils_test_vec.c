@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2026 Parrot S.A.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of the Parrot Company nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE PARROT COMPANY BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file futils_test_vec.c
+ *
+ * @brief vec unit tests
+ *
+ */
+
+#include "futils_test.h"
+
+#define NB_TEST_ELEMS 1000
+
+static void test_vec_basic(void)
+{
+	struct futils_vec vec;
+	uint32_t value, *data;
+	uint32_t i;
+	int ret;
+
+	ret = futils_vec_init(NULL, sizeof(uint32_t), NULL, 0);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_vec_init(&vec, 0, NULL, 0);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+
+	ret = futils_vec_init(&vec, sizeof(uint32_t), NULL, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(futils_vec_count(&vec), 0);
+	CU_ASSERT_PTR_NULL(futils_vec_get(&vec, 0));
+	ret = futils_vec_pop(&vec, &value);
+	CU_ASSERT_EQUAL(ret, -ENOENT);
+
+	for (i = 0; i < NB_TEST_ELEMS; i++) {
+		ret = futils_vec_push(&vec, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_EQUAL(futils_vec_count(&vec), NB_TEST_ELEMS);
+	CU_ASSERT(vec.capacity >= NB_TEST_ELEMS);
+
+	data = futils_vec_data(&vec, uint32_t);
+	for (i = 0; i < NB_TEST_ELEMS; i++)
+		CU_ASSERT_EQUAL(data[i], i);
+
+	/* insert at front, erase it back */
+	value = 1234;
+	ret = futils_vec_insert(&vec, 0, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_vec_get(&vec, 0), 1234);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_vec_get(&vec, 1), 0);
+	ret = futils_vec_insert(&vec, NB_TEST_ELEMS + 2, &value);
+	CU_ASSERT_EQUAL(ret, -EINVAL);
+	ret = futils_vec_erase(&vec, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_vec_get(&vec, 0), 0);
+
+	/* swap remove replaces with last */
+	ret = futils_vec_swap_remove(&vec, 0);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(*(uint32_t *)futils_vec_get(&vec, 0),
+			NB_TEST_ELEMS - 1);
+	CU_ASSERT_EQUAL(futils_vec_count(&vec), NB_TEST_ELEMS - 1);
+
+	ret = futils_vec_pop(&vec, &value);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(value, NB_TEST_ELEMS - 2);
+
+	ret = futils_vec_clear(&vec);
+	CU_ASSERT_EQUAL(ret, 0);
+	ret = futils_vec_shrink(&vec);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(vec.capacity, 0);
+
+	futils_vec_destroy(&vec);
+}
+
+static void test_vec_inline(void)
+{
+	struct futils_vec vec;
+	uint32_t buf[4];
+	uint32_t i;
+	int ret;
+
+	ret = futils_vec_init(&vec, sizeof(uint32_t), buf, 4);
+	CU_ASSERT_EQUAL(ret, 0);
+
+	/* first elements are in caller buffer */
+	for (i = 0; i < 4; i++) {
+		ret = futils_vec_push(&vec, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_PTR_EQUAL(vec.data, buf);
+
+	/* then moved to allocated memory */
+	for (i = 4; i < 100; i++) {
+		ret = futils_vec_push(&vec, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT(vec.data != (void *)buf);
+	for (i = 0; i < 100; i++)
+		CU_ASSERT_EQUAL(futils_vec_data(&vec, uint32_t)[i], i);
+
+	ret = futils_vec_reserve(&vec, 1000);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT(vec.capacity >= 1000);
+
+	/* shrink to fit, then back to caller buffer */
+	ret = futils_vec_shrink(&vec);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_EQUAL(vec.capacity, 100);
+	while (futils_vec_count(&vec) > 3)
+		futils_vec_pop(&vec, NULL);
+	ret = futils_vec_shrink(&vec);
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT_PTR_EQUAL(vec.data, buf);
+	CU_ASSERT_EQUAL(buf[0], 0);
+	CU_ASSERT_EQUAL(buf[2], 2);
+
+	futils_vec_destroy(&vec);
+}
+
+static void test_vec_self_insert(void)
+{
+	struct futils_vec vec;
+	uint32_t buf[4];
+	uint32_t i, *data;
+	int ret;
+
+	ret = futils_vec_init(&vec, sizeof(uint32_t), buf, 4);
+	CU_ASSERT_EQUAL(ret, 0);
+	for (i = 0; i < 4; i++) {
+		ret = futils_vec_push(&vec, &i);
+		CU_ASSERT_EQUAL(ret, 0);
+	}
+	CU_ASSERT_PTR_EQUAL(vec.data, buf);
+
+	/* caller buffer is full: push moves storage out of it */
+	ret = futils_vec_push(&vec, futils_vec_get(&vec, 0));
+	CU_ASSERT_EQUAL(ret, 0);
+	CU_ASSERT(vec.data != (void *)buf);
+	data = futils_vec_data(&vec, uint32_t);
+	CU_ASSERT_EQUAL(futils_vec_count(&vec), 5);
+	CU_ASSERT_EQUAL(data[4], 0);
+
+	/* inserted element is shifted by the insertion */
+	ret = futils_vec_insert(&vec, 0, futils_vec_get(&vec, 3));
+	CU_ASSERT_EQUAL(ret, 0);
+	data = futils_vec_data(&vec, uint32_t);
+	CU_ASSERT_EQUAL(data[0], 3);
+	CU_ASSERT_EQUAL(data[1], 0);
+	CU_ASSERT_EQUAL(data[4], 3);
+
+	/* element before insertion point is not shifted */
+	ret = futils_vec_insert(&vec, 2, futils_vec_get(&vec, 0));
+	CU_ASSERT_EQUAL(ret, 0);
+	data = futils_vec_data(&vec, uint32_t);
+	CU_ASSERT_EQUAL(data[2], 3);
+	CU_ASSERT_EQUAL(data[3], 1);
+
+	futils_vec_destroy(&vec);
+}
+
+CU_TestInfo s_vec_tests[] = {
+	{(char *)"basic", &test_vec_basic},
+	{(char *)"inline", &test_vec_inline},
+	{(char *)"self insert", &test_vec_self_insert},
+	CU_TEST_INFO_NULL,
+};